@@ -4,24 +4,72 @@
 #define DISPLAY_W 800
 #define DISPLAY_H 480
 
-// Font cell size
-#define TERM_FONT_W 10
-#define TERM_FONT_H 20
+// Minimum horizontal margin to avoid bezel clipping; the grid is centered
+// (10x20 landscape: 78 cols, 10px each side)
+#define TERM_MARGIN_X 8
 
-// Horizontal margin to avoid bezel clipping
-#define TERM_OFFSET_X 10
-
-// Terminal grid (with margin: 10 + 78*10 = 790, leaving 10px right margin)
-#define TERM_COLS ((DISPLAY_W - TERM_OFFSET_X * 2) / TERM_FONT_W)  // 78
-#define TERM_ROWS (DISPLAY_H / TERM_FONT_H)  // 24
+// The grid is sized at runtime from the font and orientation. Storage is
+// sized for the largest: 8x16 gives 98x30 landscape, 58x50 portrait.
+#define TERM_MAX_COLS  98
+#define TERM_MAX_ROWS  50
+#define TERM_MAX_CELLS (98 * 30)
 
 // Display refresh thresholds
-#define DIRTY_ROWS_PARTIAL_MAX  5       // Use partial update for <= this many dirty rows
-#define FULL_REFRESH_INTERVAL   20      // Full refresh every N fast refreshes
+#define REFRESH_WINDOW_COST     24000   // Overhead of one more refresh window, in pixels of area
+#define REFRESH_MAX_WINDOWS     4       // Damage is refreshed as at most this many windows
 #define MIN_REFRESH_INTERVAL_MS 300     // Minimum ms between display refreshes
+#define SYNC_OUTPUT_TIMEOUT_MS  1000    // Max ms to hold rendering in synchronized output mode
+#define ECHO_MAX_CELLS          4       // Damage this small (a keystroke's echo) skips the rate limit
+#define ECHO_QUIET_MS           20      // once input has paused this long
+
+// Draw into a framebuffer of the renderer's own (48 KB) and copy what
+// changed to the panel's on commit, so the next frame is drawn while the
+// panel is still refreshing the last. 0 draws into the panel's directly
+// and frees the 48 KB, at the cost of drawing waiting on each refresh.
+#define RENDER_BACK_BUFFER 1
+
+// Ghosting: fast refreshes leave traces, counted as pixel transitions per
+// band of panel rows. A band over budget is cleaned on its own; leftovers
+// get a full refresh once the host has been quiet for a while.
+#define GHOST_BAND_ROWS   40                                   // Panel rows per band
+#define GHOST_BAND_BUDGET (DISPLAY_W * GHOST_BAND_ROWS)        // Transitions before a band is cleaned
+#define GHOST_CLEAN_MAX_BANDS 3                                // Bands cleaned per refresh
+#define GHOST_IDLE_MIN    (GHOST_BAND_BUDGET / 4)              // Worth a full refresh when idle
+#define IDLE_CLEANUP_MS   10000                                // Quiet time before that refresh
+
+// Composed glyph rasters kept in RAM (about 110 bytes each)
+#define GLYPH_CACHE_ENTRIES 128
 
-// Serial
+// Scrollback: compressed history of lines scrolled off the main screen,
+// per session. A line costs 8 bytes plus about a byte per character, so
+// 16 KB keeps some 340 lines of 40-column text; oldest lines are dropped
+// beyond it.
+#define SCROLLBACK_BYTES 16384
+
+// Virtual consoles multiplexed over the serial link (at most 10); each
+// has its own grid and scrollback. A third fits without the back buffer.
+#define TERM_SESSIONS 2
+
+// Static RAM. The ESP32-C3 has about 320 KB of DRAM for data, which also
+// holds the heap, the task stacks and the USB/IDF runtime; main.cpp checks
+// that the large static objects (sessions, the shared scrollback view,
+// renderer, input ring, panel framebuffer) stay within this, leaving over
+// 100 KB for the rest. Sessions cost about 20 KB each plus their
+// scrollback, the back buffer 48 KB.
+#define STATIC_RAM_BUDGET (208 * 1024)
+
+// Serial. USB CDC ignores the baud rate; TERM_UART 1 also takes input
+// from the UART0 RX pin at TERM_BAUD (receive only: replies and flow
+// control go over USB).
 #define TERM_BAUD 115200
+#define TERM_UART 0
+#define RX_RING_BYTES 8192                 // Input buffered ahead of the parser (power of two)
+#define RX_XOFF_AT    (RX_RING_BYTES / 2)  // Host is sent XOFF with this much waiting
+#define RX_XON_AT     (RX_RING_BYTES / 8)  // and XON once drained to this
+
+// Identification (XTVERSION)
+#define TERM_NAME    "X4Term"
+#define TERM_VERSION "1.0"
 
 // Tab width
 #define TAB_WIDTH 8
@@ -0,0 +1,54 @@
+#include "LineCodec.h"
+
+namespace LineCodec {
+
+size_t encode(const TermCell* row, int cols, const StyleTable& styles, uint8_t* out) {
+  constexpr uint8_t REPEAT = 0xFF;  // never a UTF-8 byte
+
+  // Trim trailing default blanks
+  while (cols > 0 && row[cols - 1].codepoint == ' ' &&
+         row[cols - 1].style == StyleTable::DEFAULT) {
+    cols--;
+  }
+
+  size_t len = 0;
+  int c = 0;
+  while (c < cols) {
+    uint8_t id = row[c].style;
+    int end = c + 1;
+    while (end < cols && end - c < 255 && row[end].style == id) end++;
+    const TermStyle& st = styles[id];
+    out[len++] = end - c;
+    out[len++] = st.fg;
+    out[len++] = st.bg;
+    out[len++] = st.attrs;
+
+    for (int i = c; i < end;) {
+      uint16_t cp = row[i].codepoint;
+      if (cp < 0x80) {
+        out[len++] = cp;
+      } else if (cp < 0x800) {
+        out[len++] = 0xC0 | (cp >> 6);
+        out[len++] = 0x80 | (cp & 0x3F);
+      } else {
+        out[len++] = 0xE0 | (cp >> 12);
+        out[len++] = 0x80 | ((cp >> 6) & 0x3F);
+        out[len++] = 0x80 | (cp & 0x3F);
+      }
+      // Rules and padding: collapse 3+ identical cells to a repeat count
+      int k = 1;
+      while (i + k < end && k <= 255 && row[i + k].codepoint == cp) k++;
+      if (k >= 3) {
+        out[len++] = REPEAT;
+        out[len++] = k - 1;
+        i += k;
+      } else {
+        i++;
+      }
+    }
+    c = end;
+  }
+  return len;
+}
+
+}  // namespace LineCodec
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "TermCell.h"
+#include "TermStyle.h"
+#include "term_config.h"
+
+// Compact encoding of a row of cells, used by the scrollback and the sleep
+// snapshot:
+//
+//   line   := run*
+//   run    := cells:u8 fg:u8 bg:u8 attrs:u8 chars
+//   chars  := UTF-8 per cell, or 0xFF k = previous character k more times
+//
+// Styles are stored by value, so a line outlives the StyleTable ids of the
+// grid it came from. Trailing default blanks are trimmed: ASCII text costs
+// one byte per character plus four bytes per style run.
+namespace LineCodec {
+
+// Upper bound of an encoded line: a run header and a 3-byte character per cell
+constexpr size_t MAX_BYTES = 7 * TERM_MAX_COLS;
+
+// Encode cols cells into out (MAX_BYTES); returns the encoded length
+size_t encode(const TermCell* row, int cols, const StyleTable& styles, uint8_t* out);
+
+// Decode len bytes read through fetch(i): sink(col, codepoint, style) for
+// each stored cell below cols
+template <typename Fetch, typename Sink>
+void decode(size_t len, Fetch&& fetch, int cols, Sink&& sink) {
+  constexpr uint8_t REPEAT = 0xFF;
+  size_t pos = 0;
+  int col = 0;
+  uint16_t prev = ' ';
+  while (pos < len && col < cols) {
+    int count = fetch(pos);
+    TermStyle style;
+    style.fg = fetch(pos + 1);
+    style.bg = fetch(pos + 2);
+    style.attrs = fetch(pos + 3);
+    pos += 4;
+    while (count > 0 && pos < len) {
+      uint8_t b = fetch(pos++);
+      int repeat = 1;
+      uint16_t cp;
+      if (b == REPEAT) {
+        cp = prev;
+        repeat = fetch(pos++);
+      } else if (b < 0x80) {
+        cp = b;
+      } else if (b < 0xE0) {
+        cp = ((b & 0x1F) << 6) | (fetch(pos) & 0x3F);
+        pos += 1;
+      } else {
+        cp = ((b & 0x0F) << 12) | ((fetch(pos) & 0x3F) << 6) | (fetch(pos + 1) & 0x3F);
+        pos += 2;
+      }
+      for (; repeat > 0 && count > 0; repeat--, count--) {
+        if (col < cols) sink(col, cp, style);
+        col++;
+      }
+      prev = cp;
+    }
+  }
+}
+
+}  // namespace LineCodec
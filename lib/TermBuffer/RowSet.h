@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include "term_config.h"
+
+// Set of row indices below TERM_MAX_ROWS, one bit per row (dirty tracking)
+class RowSet {
+ public:
+  bool test(int row) const { return _w[row >> 5] & (1u << (row & 31)); }
+  void set(int row) { _w[row >> 5] |= 1u << (row & 31); }
+  void reset(int row) { _w[row >> 5] &= ~(1u << (row & 31)); }
+  void clear() {
+    for (int i = 0; i < WORDS; i++) _w[i] = 0;
+  }
+  // Set rows [0, n)
+  void setFirst(int n) {
+    for (int i = 0; i < WORDS; i++) {
+      int bits = n - i * 32;
+      _w[i] = bits >= 32 ? ~0u : bits > 0 ? (1u << bits) - 1 : 0;
+    }
+  }
+
+  bool any() const {
+    for (int i = 0; i < WORDS; i++)
+      if (_w[i]) return true;
+    return false;
+  }
+  int count() const {
+    int n = 0;
+    for (int i = 0; i < WORDS; i++) n += __builtin_popcount(_w[i]);
+    return n;
+  }
+  // Lowest / highest row in the set, -1 if empty
+  int first() const {
+    for (int i = 0; i < WORDS; i++)
+      if (_w[i]) return i * 32 + __builtin_ctz(_w[i]);
+    return -1;
+  }
+  int last() const {
+    for (int i = WORDS - 1; i >= 0; i--)
+      if (_w[i]) return i * 32 + 31 - __builtin_clz(_w[i]);
+    return -1;
+  }
+
+ private:
+  static constexpr int WORDS = (TERM_MAX_ROWS + 31) / 32;
+  uint32_t _w[WORDS] = {};
+};
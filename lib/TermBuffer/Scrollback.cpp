@@ -0,0 +1,53 @@
+#include "Scrollback.h"
+
+void Scrollback::write16(size_t pos, uint16_t v) {
+  _buf[wrap(pos)] = v & 0xFF;
+  _buf[wrap(pos + 1)] = v >> 8;
+}
+
+void Scrollback::evictOldest() {
+  size_t len = read16(_tail);
+  _tail = wrap(_tail + len + 4);
+  _used -= len + 4;
+  _lines--;
+}
+
+void Scrollback::push(const TermCell* row, int cols, const StyleTable& styles) {
+  uint8_t rec[LineCodec::MAX_BYTES];
+  size_t len = LineCodec::encode(row, cols, styles, rec);
+
+  size_t need = len + 4;
+  if (need > _size) return;
+  while (_size - _used < need) evictOldest();
+
+  size_t pos = _tail + _used;
+  write16(pos, len);
+  for (size_t i = 0; i < len; i++) _buf[wrap(pos + 2 + i)] = rec[i];
+  write16(pos + 2 + len, len);
+  _used += need;
+  _lines++;
+}
+
+void Scrollback::save(StateWriter& w) const {
+  w.u32(_used);
+  w.u32(_lines);
+  // The ring may wrap: write it as at most two runs
+  size_t first = _used < _size - _tail ? _used : _size - _tail;
+  w.write(&_buf[_tail], first);
+  w.write(_buf, _used - first);
+}
+
+bool Scrollback::restore(StateReader& r) {
+  clear();
+  size_t used = r.u32();
+  int lines = r.u32();
+  if (!r.ok() || used > _size) {
+    r.fail();
+    return false;
+  }
+  r.bytes(_buf, used);
+  if (!r.ok()) return false;
+  _used = used;
+  _lines = lines;
+  return true;
+}
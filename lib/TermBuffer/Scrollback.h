@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "LineCodec.h"
+#include "StateIO.h"
+#include "TermCell.h"
+#include "TermStyle.h"
+
+// Compressed history of lines scrolled off the top of the main screen.
+//
+// Lines are LineCodec records in a byte ring over caller-provided storage;
+// the oldest lines are evicted when it fills. Each record is framed as
+//
+//   len:u16  line  len:u16          (len = line bytes, at both ends so
+//                                    the ring can be walked either way)
+class Scrollback {
+ public:
+  Scrollback(uint8_t* storage, size_t size) : _buf(storage), _size(size) {}
+
+  // Append a line (cols cells, styles resolved through the table)
+  void push(const TermCell* row, int cols, const StyleTable& styles);
+
+  // Decode line n (1 = newest): sink(col, codepoint, style) for each
+  // stored cell. Returns false if there is no such line.
+  template <typename Sink>
+  bool read(int n, int cols, Sink&& sink) const;
+
+  int lines() const { return _lines; }
+  size_t bytesUsed() const { return _used; }
+  void clear() { _tail = _used = 0; _lines = 0; }
+
+  // Persist the history (oldest record first). restore() returns false,
+  // leaving the history empty, if the saved lines do not fit.
+  void save(StateWriter& w) const;
+  bool restore(StateReader& r);
+
+ private:
+  uint8_t* _buf;
+  size_t _size;
+  size_t _tail = 0;  // oldest record
+  size_t _used = 0;
+  int _lines = 0;
+
+  size_t wrap(size_t pos) const { return pos % _size; }
+  uint8_t at(size_t pos) const { return _buf[wrap(pos)]; }
+  uint16_t read16(size_t pos) const { return at(pos) | (at(pos + 1) << 8); }
+  void write16(size_t pos, uint16_t v);
+  void evictOldest();
+};
+
+template <typename Sink>
+bool Scrollback::read(int n, int cols, Sink&& sink) const {
+  if (n < 1 || n > _lines) return false;
+  // Walk back from the newest record using the trailing lengths
+  size_t end = wrap(_tail + _used);
+  for (int i = 0; i < n; i++) {
+    size_t len = read16(end + _size - 2);
+    end = wrap(end + _size - len - 4);
+  }
+  size_t start = end + 2;
+  LineCodec::decode(read16(end), [&](size_t i) { return at(start + i); }, cols, sink);
+  return true;
+}
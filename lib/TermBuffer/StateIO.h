@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Byte streams for saving terminal state (TermBuffer, VtParser,
+// Scrollback) to wherever the caller keeps it. Little-endian.
+class StateWriter {
+ public:
+  virtual void write(const uint8_t* data, size_t n) = 0;
+
+  void u8(uint8_t v) { write(&v, 1); }
+  void u16(uint16_t v) {
+    uint8_t b[2] = {uint8_t(v), uint8_t(v >> 8)};
+    write(b, 2);
+  }
+  void u32(uint32_t v) {
+    u16(v);
+    u16(v >> 16);
+  }
+};
+
+// Reads stop at the first short read: ok() goes false and every later
+// value reads as zero, so callers check once at the end.
+class StateReader {
+ public:
+  virtual bool read(uint8_t* data, size_t n) = 0;
+
+  bool ok() const { return _ok; }
+  void fail() { _ok = false; }
+
+  void bytes(uint8_t* data, size_t n) {
+    if (_ok && !read(data, n)) _ok = false;
+    if (!_ok) {
+      for (size_t i = 0; i < n; i++) data[i] = 0;
+    }
+  }
+  uint8_t u8() {
+    uint8_t v;
+    bytes(&v, 1);
+    return v;
+  }
+  uint16_t u16() {
+    uint8_t b[2];
+    bytes(b, 2);
+    return b[0] | (b[1] << 8);
+  }
+  uint32_t u32() {
+    uint32_t lo = u16();
+    return lo | (uint32_t(u16()) << 16);
+  }
+
+ private:
+  bool _ok = true;
+};
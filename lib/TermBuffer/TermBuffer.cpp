@@ -1,27 +1,182 @@
 #include "TermBuffer.h"
+#include "LineCodec.h"
+#include <algorithm>
 #include <cstring>
 
-TermBuffer::TermBuffer() {
-  for (int r = 0; r < TERM_ROWS; r++)
+// Clamp a grid size to the cell storage
+static void fitGrid(int& cols, int& rows) {
+  if (cols < 1) cols = 1;
+  if (cols > TERM_MAX_COLS) cols = TERM_MAX_COLS;
+  if (rows < 1) rows = 1;
+  if (rows > TERM_MAX_ROWS) rows = TERM_MAX_ROWS;
+  if (cols * rows > TERM_MAX_CELLS) rows = TERM_MAX_CELLS / cols;
+}
+
+TermCell TermBuffer::_viewPool[TERM_MAX_CELLS];
+
+TermBuffer::TermBuffer(int cols, int rows) {
+  fitGrid(cols, rows);
+  _numCols = cols;
+  _numRows = rows;
+  _scrollBottom = rows - 1;
+  for (int s = 0; s < 3; s++) layoutRows(s);
+  _rows = _rowTables[1];
+  _wrapped = _wrapTables[1];
+  for (int r = 0; r < _numRows; r++)
     clearRow(r);
+  _rows = _rowTables[0];
+  _wrapped = _wrapTables[0];
+  for (int r = 0; r < _numRows; r++)
+    clearRow(r);
+  _visible = _rows;
   markAllDirty();
 }
 
+// Point a screen's row table at consecutive rows of its pool
+void TermBuffer::layoutRows(int screen) {
+  for (int r = 0; r < _numRows; r++) {
+    _rowTables[screen][r] = &pool(screen)[r * _numCols];
+  }
+}
+
+// Copy a screen's rows, top to bottom, to dst as one cols x rows block
+void TermBuffer::copyRowsOut(int screen, TermCell* dst) const {
+  for (int r = 0; r < _numRows; r++) {
+    memcpy(&dst[r * _numCols], _rowTables[screen][r], sizeof(TermCell) * _numCols);
+  }
+}
+
+void TermBuffer::resize(int cols, int rows) {
+  fitGrid(cols, rows);
+  if (cols == _numCols && rows == _numRows) return;
+
+  // The view pool is scratch space for the old contents
+  _viewOffset = 0;
+  TermCell* old = _viewPool;
+  int oldCols = _numCols, oldRows = _numRows;
+  int mainRow = _altActive ? _altSavedRow : _curRow;
+  int mainCol = _altActive ? _altSavedCol : _curCol;
+  uint8_t oldWrapped[TERM_MAX_ROWS];
+  memcpy(oldWrapped, _wrapTables[0], oldRows);
+
+  // Alternate screen: keep the top-left corner
+  copyRowsOut(1, old);
+  _numCols = cols;
+  _numRows = rows;
+  layoutRows(1);
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < cols; c++) {
+      bool keep = r < oldRows && c < oldCols;
+      _rowTables[1][r][c] = keep ? old[r * oldCols + c] : TermCell();
+    }
+    _wrapTables[1][r] = 0;
+  }
+
+  // Main screen: rewrap each line (rows joined by autowrap) at the new width
+  _numCols = oldCols;
+  _numRows = oldRows;
+  copyRowsOut(0, old);
+  _numCols = cols;
+  _numRows = rows;
+  layoutRows(0);
+  _rows = _rowTables[0];
+  _wrapped = _wrapTables[0];
+  for (int r = 0; r < rows; r++) clearRow(r);
+
+  int last = mainRow;  // last row with content (or the cursor)
+  for (int r = oldRows - 1; r > last; r--) {
+    const TermCell* src = &old[r * oldCols];
+    bool blank = true;
+    for (int c = 0; c < oldCols && blank; c++) blank = src[c] == TermCell();
+    if (!blank) last = r;
+  }
+
+  int row = 0, col = 0;
+  int curRow = 0, curCol = 0;
+  for (int r = 0; r <= last;) {
+    int end = r;
+    while (end < last && oldWrapped[end]) end++;
+    const TermCell* src = &old[r * oldCols];
+    int len = (end - r + 1) * oldCols;
+    while (len > 0 && src[len - 1] == TermCell()) len--;
+    int cursorAt = -1;
+    if (mainRow >= r && mainRow <= end) cursorAt = (mainRow - r) * oldCols + mainCol;
+
+    int n = len > cursorAt ? len : cursorAt + 1;
+    for (int i = 0; i < n; i++) {
+      if (col == cols) {
+        _wrapped[row] = 1;
+        row = reflowNewLine(row, curRow);
+        col = 0;
+      }
+      if (i == cursorAt) {
+        curRow = row;
+        curCol = col;
+      }
+      if (i < len) _rows[row][col] = src[i];
+      col++;
+    }
+
+    r = end + 1;
+    if (r <= last) {
+      row = reflowNewLine(row, curRow);
+      col = 0;
+    }
+  }
+
+  if (_altActive) {
+    _altSavedRow = curRow;
+    _altSavedCol = curCol;
+    _rows = _rowTables[1];
+    _wrapped = _wrapTables[1];
+    clampCursor();
+  } else {
+    _curRow = curRow;
+    _curCol = curCol;
+  }
+  if (_savedRow >= rows) _savedRow = rows - 1;
+  if (_savedCol >= cols) _savedCol = cols - 1;
+  layoutRows(2);
+  _scrollTop = 0;
+  _scrollBottom = rows - 1;
+  _wrapPending = false;
+  _visible = _rows;
+  markAllDirty();
+}
+
+// Next output row of a main screen reflow; at the bottom the top row goes
+// to the scrollback and the rows move up (cursorRow with them)
+int TermBuffer::reflowNewLine(int row, int& cursorRow) {
+  if (row + 1 < _numRows) return row + 1;
+  if (_scrollback) _scrollback->push(_rows[0], _numCols, _styles);
+  rotateRows(0, 1, _numRows);
+  clearRow(_numRows - 1);
+  if (cursorRow > 0) cursorRow--;
+  return row;
+}
+
+// std::rotate over the active screen's rows and their wrap flags
+void TermBuffer::rotateRows(int first, int middle, int last) {
+  std::rotate(&_rows[first], &_rows[middle], &_rows[last]);
+  std::rotate(&_wrapped[first], &_wrapped[middle], &_wrapped[last]);
+}
+
 void TermBuffer::clampCursor() {
   if (_curRow < 0) _curRow = 0;
-  if (_curRow >= TERM_ROWS) _curRow = TERM_ROWS - 1;
+  if (_curRow >= _numRows) _curRow = _numRows - 1;
   if (_curCol < 0) _curCol = 0;
-  if (_curCol >= TERM_COLS) _curCol = TERM_COLS - 1;
+  if (_curCol >= _numCols) _curCol = _numCols - 1;
 }
 
 void TermBuffer::clearRow(int row) {
-  for (int c = 0; c < TERM_COLS; c++)
-    _cells[row][c].clear();
+  for (int c = 0; c < _numCols; c++)
+    _rows[row][c].clear();
+  _wrapped[row] = 0;
   markRowDirty(row);
 }
 
 void TermBuffer::clearCell(int row, int col) {
-  _cells[row][col].clear();
+  _rows[row][col].clear();
 }
 
 void TermBuffer::putChar(uint16_t cp) {
@@ -29,21 +184,76 @@ void TermBuffer::putChar(uint16_t cp) {
   // wrap now before placing this character
   if (_wrapPending) {
     _wrapPending = false;
+    _wrapped[_curRow] = 1;
     _curCol = 0;
     lineFeed();
   }
-  _cells[_curRow][_curCol].codepoint = cp;
-  _cells[_curRow][_curCol].attrs = _attrs;
-  _cells[_curRow][_curCol].bgBright = _bgBright;
-  markRowDirty(_curRow);
+  _rows[_curRow][_curCol].codepoint = cp;
+  _rows[_curRow][_curCol].style = penStyle();
+  _lastChar = cp;
+  markDirty(_curRow, _curCol, _curCol);
   _curCol++;
   // If we just wrote the last column, defer the wrap
-  if (_curCol >= TERM_COLS) {
-    _curCol = TERM_COLS - 1;
+  if (_curCol >= _numCols) {
+    _curCol = _numCols - 1;
     _wrapPending = true;
   }
 }
 
+// Resolve a pending wrap and return how many of n cells fit on the
+// cursor row
+int TermBuffer::beginSpan(int n) {
+  if (_wrapPending) {
+    _wrapPending = false;
+    _wrapped[_curRow] = 1;
+    _curCol = 0;
+    lineFeed();
+  }
+  int count = _numCols - _curCol;
+  return count < n ? count : n;
+}
+
+// Account for count cells written at the cursor
+void TermBuffer::endSpan(int count) {
+  markDirty(_curRow, _curCol, _curCol + count - 1);
+  _curCol += count;
+  if (_curCol >= _numCols) {
+    _curCol = _numCols - 1;
+    _wrapPending = true;
+  }
+}
+
+void TermBuffer::putChars(const uint8_t* s, int n, const uint16_t* charset) {
+  uint8_t style = penStyle();
+  while (n > 0) {
+    int count = beginSpan(n);
+    TermCell* cell = &_rows[_curRow][_curCol];
+    for (int i = 0; i < count; i++) {
+      cell[i].codepoint = charset ? charset[s[i]] : s[i];
+      cell[i].style = style;
+    }
+    _lastChar = cell[count - 1].codepoint;
+    endSpan(count);
+    s += count;
+    n -= count;
+  }
+}
+
+void TermBuffer::repeatChar(int n) {
+  if (_lastChar == 0) return;
+  uint8_t style = penStyle();
+  while (n > 0) {
+    int count = beginSpan(n);
+    TermCell* cell = &_rows[_curRow][_curCol];
+    for (int i = 0; i < count; i++) {
+      cell[i].codepoint = _lastChar;
+      cell[i].style = style;
+    }
+    endSpan(count);
+    n -= count;
+  }
+}
+
 void TermBuffer::setCursor(int row, int col) {
   _curRow = row;
   _curCol = col;
@@ -59,13 +269,13 @@ void TermBuffer::moveCursorUp(int n) {
 
 void TermBuffer::moveCursorDown(int n) {
   _curRow += n;
-  if (_curRow >= TERM_ROWS) _curRow = TERM_ROWS - 1;
+  if (_curRow >= _numRows) _curRow = _numRows - 1;
   _wrapPending = false;
 }
 
 void TermBuffer::moveCursorForward(int n) {
   _curCol += n;
-  if (_curCol >= TERM_COLS) _curCol = TERM_COLS - 1;
+  if (_curCol >= _numCols) _curCol = _numCols - 1;
   _wrapPending = false;
 }
 
@@ -82,8 +292,8 @@ void TermBuffer::carriageReturn() {
 
 void TermBuffer::lineFeed() {
   if (_curRow == _scrollBottom) {
-    scrollUp(1);
-  } else if (_curRow < TERM_ROWS - 1) {
+    scrollRegionUp(_scrollTop, _scrollBottom, 1, true);
+  } else if (_curRow < _numRows - 1) {
     _curRow++;
   }
 }
@@ -98,7 +308,7 @@ void TermBuffer::reverseIndex() {
 
 void TermBuffer::tab() {
   int nextStop = ((_curCol / TAB_WIDTH) + 1) * TAB_WIDTH;
-  if (nextStop >= TERM_COLS) nextStop = TERM_COLS - 1;
+  if (nextStop >= _numCols) nextStop = _numCols - 1;
   _curCol = nextStop;
   _wrapPending = false;
 }
@@ -109,13 +319,15 @@ void TermBuffer::backspace() {
 }
 
 void TermBuffer::eraseLine(int mode) {
-  markRowDirty(_curRow);
   switch (mode) {
     case 0:  // cursor to end
-      for (int c = _curCol; c < TERM_COLS; c++) clearCell(_curRow, c);
+      for (int c = _curCol; c < _numCols; c++) clearCell(_curRow, c);
+      _wrapped[_curRow] = 0;
+      markDirty(_curRow, _curCol, _numCols - 1);
       break;
     case 1:  // start to cursor
       for (int c = 0; c <= _curCol; c++) clearCell(_curRow, c);
+      markDirty(_curRow, 0, _curCol);
       break;
     case 2:  // entire line
       clearRow(_curRow);
@@ -127,21 +339,21 @@ void TermBuffer::eraseDisplay(int mode) {
   switch (mode) {
     case 0:  // cursor to end
       eraseLine(0);
-      for (int r = _curRow + 1; r < TERM_ROWS; r++) clearRow(r);
+      for (int r = _curRow + 1; r < _numRows; r++) clearRow(r);
       break;
     case 1:  // start to cursor
       for (int r = 0; r < _curRow; r++) clearRow(r);
       eraseLine(1);
       break;
     case 2:  // entire display
-      for (int r = 0; r < TERM_ROWS; r++) clearRow(r);
+      for (int r = 0; r < _numRows; r++) clearRow(r);
       break;
   }
 }
 
 void TermBuffer::setScrollRegion(int top, int bottom) {
   if (top < 0) top = 0;
-  if (bottom >= TERM_ROWS) bottom = TERM_ROWS - 1;
+  if (bottom >= _numRows) bottom = _numRows - 1;
   if (top >= bottom) return;
   _scrollTop = top;
   _scrollBottom = bottom;
@@ -157,13 +369,18 @@ void TermBuffer::scrollDown(int n) {
   scrollRegionDown(_scrollTop, _scrollBottom, n);
 }
 
-void TermBuffer::scrollRegionUp(int top, int bottom, int n) {
+void TermBuffer::scrollRegionUp(int top, int bottom, int n, bool toHistory) {
   if (n <= 0) return;
   if (n > bottom - top + 1) n = bottom - top + 1;
-  for (int r = top; r <= bottom - n; r++) {
-    memcpy(_cells[r], _cells[r + n], sizeof(TermCell) * TERM_COLS);
-    markRowDirty(r);
+  // Lines output pushes off the top of the main screen go to the
+  // scrollback; deleted lines (DL, SU) are gone
+  if (toHistory && _scrollback && top == 0 && !_altActive) {
+    for (int r = 0; r < n; r++) _scrollback->push(_rows[r], _numCols, _styles);
   }
+  // Rotate the region's row pointers; rows leaving the top are recycled
+  // as the blank rows at the bottom
+  rotateRows(top, top + n, bottom + 1);
+  moveRows(top, bottom, -n);
   for (int r = bottom - n + 1; r <= bottom; r++) {
     clearRow(r);
   }
@@ -172,10 +389,8 @@ void TermBuffer::scrollRegionUp(int top, int bottom, int n) {
 void TermBuffer::scrollRegionDown(int top, int bottom, int n) {
   if (n <= 0) return;
   if (n > bottom - top + 1) n = bottom - top + 1;
-  for (int r = bottom; r >= top + n; r--) {
-    memcpy(_cells[r], _cells[r - n], sizeof(TermCell) * TERM_COLS);
-    markRowDirty(r);
-  }
+  rotateRows(top, bottom + 1 - n, bottom + 1);
+  moveRows(top, bottom, n);
   for (int r = top; r < top + n; r++) {
     clearRow(r);
   }
@@ -192,25 +407,143 @@ void TermBuffer::deleteLines(int n) {
 }
 
 void TermBuffer::insertChars(int n) {
-  markRowDirty(_curRow);
-  for (int c = TERM_COLS - 1; c >= _curCol + n; c--) {
-    _cells[_curRow][c] = _cells[_curRow][c - n];
+  if (n > _numCols - _curCol) n = _numCols - _curCol;
+  moveCells(_curCol, n);
+  for (int c = _numCols - 1; c >= _curCol + n; c--) {
+    _rows[_curRow][c] = _rows[_curRow][c - n];
   }
-  for (int c = _curCol; c < _curCol + n && c < TERM_COLS; c++) {
+  for (int c = _curCol; c < _curCol + n && c < _numCols; c++) {
     clearCell(_curRow, c);
   }
 }
 
 void TermBuffer::deleteChars(int n) {
-  markRowDirty(_curRow);
-  for (int c = _curCol; c < TERM_COLS - n; c++) {
-    _cells[_curRow][c] = _cells[_curRow][c + n];
+  if (n > _numCols - _curCol) n = _numCols - _curCol;
+  moveCells(_curCol, -n);
+  for (int c = _curCol; c < _numCols - n; c++) {
+    _rows[_curRow][c] = _rows[_curRow][c + n];
   }
-  for (int c = TERM_COLS - n; c < TERM_COLS; c++) {
+  for (int c = _numCols - n; c < _numCols; c++) {
     clearCell(_curRow, c);
   }
 }
 
+// Rows [top, bottom] moved by delta: their dirty marks go along, and
+// the move is recorded. The rows it exposes are cleared by the caller.
+void TermBuffer::moveRows(int top, int bottom, int delta) {
+  int n = delta < 0 ? -delta : delta;
+  if (n > bottom - top) return;  // all exposed
+  for (int i = 0; i <= bottom - top - n; i++) {
+    int to = delta < 0 ? top + i : bottom - i;
+    int from = to - delta;
+    if (_dirtyRows.test(from)) {
+      _dirtyRows.set(to);
+      _dirtyMin[to] = _dirtyMin[from];
+      _dirtyMax[to] = _dirtyMax[from];
+    } else {
+      _dirtyRows.reset(to);
+    }
+  }
+  addMove({false, (uint8_t)top, (uint8_t)bottom, 0, (int8_t)delta});
+}
+
+// Cells [col, cols) of the cursor row moved by delta; the cells it
+// exposes are marked dirty. A row already dirty is dirty from col on.
+void TermBuffer::moveCells(int col, int delta) {
+  if (delta == 0) return;
+  int n = delta < 0 ? -delta : delta;
+  if (_dirtyRows.test(_curRow) && _dirtyMax[_curRow] >= col) {
+    markDirty(_curRow, col, _numCols - 1);
+  }
+  if (delta > 0) {
+    markDirty(_curRow, col, col + n - 1);
+  } else {
+    markDirty(_curRow, _numCols - n, _numCols - 1);
+  }
+  if (n < _numCols - col) {
+    addMove({true, (uint8_t)_curRow, (uint8_t)_curRow, (uint8_t)col, (int8_t)delta});
+  }
+}
+
+// Queue a move, folding it into the last one where it continues it (a
+// region scrolling line by line). Not kept while the scrollback view is
+// shown or when the queue is full: everything is redrawn instead.
+void TermBuffer::addMove(const Move& m) {
+  if (_visible != _rows) return;
+  if (_moveCount > 0) {
+    Move& last = _moves[_moveCount - 1];
+    if (!m.cells && !last.cells && last.top == m.top && last.bottom == m.bottom &&
+        (last.delta < 0) == (m.delta < 0)) {
+      int delta = last.delta + m.delta;
+      int n = delta < 0 ? -delta : delta;
+      if (n > m.bottom - m.top) {
+        _moveCount--;  // nothing left of the first rows: all dirty already
+      } else {
+        last.delta = delta;
+      }
+      return;
+    }
+  }
+  if (_moveCount == MAX_MOVES) {
+    markAllDirty();
+    return;
+  }
+  _moves[_moveCount++] = m;
+}
+
+bool TermBuffer::clipRect(int& top, int& left, int& bottom, int& right) const {
+  if (top < 0) top = 0;
+  if (left < 0) left = 0;
+  if (bottom >= _numRows) bottom = _numRows - 1;
+  if (right >= _numCols) right = _numCols - 1;
+  return top <= bottom && left <= right;
+}
+
+void TermBuffer::fillRect(int top, int left, int bottom, int right, uint16_t cp) {
+  if (!clipRect(top, left, bottom, right)) return;
+  uint8_t style = penStyle();
+  for (int r = top; r <= bottom; r++) {
+    TermCell* cell = &_rows[r][left];
+    for (int c = 0; c <= right - left; c++) {
+      cell[c].codepoint = cp;
+      cell[c].style = style;
+    }
+    markDirty(r, left, right);
+  }
+}
+
+void TermBuffer::eraseRect(int top, int left, int bottom, int right) {
+  if (!clipRect(top, left, bottom, right)) return;
+  for (int r = top; r <= bottom; r++) {
+    for (int c = left; c <= right; c++) clearCell(r, c);
+    markDirty(r, left, right);
+  }
+}
+
+void TermBuffer::copyRect(int top, int left, int bottom, int right,
+                          int dstTop, int dstLeft) {
+  if (!clipRect(top, left, bottom, right)) return;
+  if (dstTop < 0 || dstLeft < 0 || dstTop >= _numRows || dstLeft >= _numCols) return;
+  // Clip the destination; the source shrinks to match
+  int rows = bottom - top + 1;
+  int cols = right - left + 1;
+  if (dstTop + rows > _numRows) rows = _numRows - dstTop;
+  if (dstLeft + cols > _numCols) cols = _numCols - dstLeft;
+  size_t bytes = sizeof(TermCell) * cols;
+  // Copy rows in the order that keeps an overlapping source intact
+  if (dstTop <= top) {
+    for (int i = 0; i < rows; i++) {
+      memmove(&_rows[dstTop + i][dstLeft], &_rows[top + i][left], bytes);
+      markDirty(dstTop + i, dstLeft, dstLeft + cols - 1);
+    }
+  } else {
+    for (int i = rows - 1; i >= 0; i--) {
+      memmove(&_rows[dstTop + i][dstLeft], &_rows[top + i][left], bytes);
+      markDirty(dstTop + i, dstLeft, dstLeft + cols - 1);
+    }
+  }
+}
+
 void TermBuffer::saveCursor() {
   _savedRow = _curRow;
   _savedCol = _curCol;
@@ -223,10 +556,11 @@ void TermBuffer::restoreCursor() {
 }
 
 void TermBuffer::eraseChars(int n) {
-  markRowDirty(_curRow);
-  for (int c = _curCol; c < _curCol + n && c < TERM_COLS; c++) {
+  int end = _curCol + n < _numCols ? _curCol + n : _numCols;
+  for (int c = _curCol; c < end; c++) {
     clearCell(_curRow, c);
   }
+  markDirty(_curRow, _curCol, end - 1);
 }
 
 void TermBuffer::switchScreen(bool alt) {
@@ -236,28 +570,185 @@ void TermBuffer::switchScreen(bool alt) {
     // Save main screen cursor, switch to alt, clear it
     _altSavedRow = _curRow;
     _altSavedCol = _curCol;
-    memcpy(_altCells, _cells, sizeof(_cells));
-    for (int r = 0; r < TERM_ROWS; r++) clearRow(r);
+    _rows = _rowTables[1];
+    _wrapped = _wrapTables[1];
+    for (int r = 0; r < _numRows; r++) clearRow(r);
     _curRow = 0;
     _curCol = 0;
   } else {
-    // Restore main screen content and cursor
-    memcpy(_cells, _altCells, sizeof(_cells));
+    // Main screen rows were never touched: just point back at them
+    _rows = _rowTables[0];
+    _wrapped = _wrapTables[0];
     _curRow = _altSavedRow;
     _curCol = _altSavedCol;
     markAllDirty();
   }
+  if (_viewOffset == 0) _visible = _rows;
 
   _scrollTop = 0;
-  _scrollBottom = TERM_ROWS - 1;
+  _scrollBottom = _numRows - 1;
   _wrapPending = false;
   _altActive = alt;
 }
 
-void TermBuffer::setAttr(uint8_t attr) { _attrs |= attr; }
-void TermBuffer::clearAttr(uint8_t attr) { _attrs &= ~attr; }
-void TermBuffer::resetAttrs() { _attrs = 0; _bgBright = 255; }
+void TermBuffer::setAttr(uint8_t attr) { _pen.attrs |= attr; _penDirty = true; }
+void TermBuffer::clearAttr(uint8_t attr) { _pen.attrs &= ~attr; _penDirty = true; }
+void TermBuffer::setFgBright(uint8_t f) { _pen.fg = f; _penDirty = true; }
+void TermBuffer::setBgBright(uint8_t b) { _pen.bg = b; _penDirty = true; }
+
+void TermBuffer::resetAttrs() {
+  _pen = TermStyle();
+  _penId = StyleTable::DEFAULT;
+  _penDirty = false;
+}
+
+// Style id for new characters. SGR only edits _pen; interning happens here,
+// once per write call rather than once per parameter or per character.
+uint8_t TermBuffer::penStyle() {
+  if (_penDirty) {
+    _penDirty = false;
+    _penId = internStyle(_pen);
+  }
+  return _penId;
+}
+
+uint8_t TermBuffer::internStyle(const TermStyle& s) {
+  uint8_t id;
+  if (_styles.intern(s, id)) return id;
+  collectStyles();
+  // Every id is on screen: fall back to the default style
+  return _styles.intern(s, id) ? id : StyleTable::DEFAULT;
+}
+
+// Free style ids no longer referenced by any cell on either screen, the
+// scrollback view or the pen
+void TermBuffer::collectStyles() {
+  _styles.beginSweep();
+  for (int s = 0; s < (_viewOffset ? 3 : 2); s++) {
+    const TermCell* cells = pool(s);
+    for (int i = 0; i < _numCols * _numRows; i++) _styles.mark(cells[i].style);
+  }
+  if (!_penDirty) _styles.mark(_penId);
+  _styles.sweep();
+}
+
+bool TermBuffer::scrollView(int delta) {
+  int offset = _viewOffset + delta;
+  int lines = _scrollback ? _scrollback->lines() : 0;
+  if (offset > lines) offset = lines;
+  if (offset < 0 || _altActive) offset = 0;
+  if (offset == _viewOffset) return false;
+  _viewOffset = offset;
+  markAllDirty();
+  if (offset == 0) {
+    _visible = _rows;
+    return true;
+  }
+
+  // Rebuild the view: history lines above a snapshot of the live screen
+  TermCell** view = _rowTables[2];
+  int hist = std::min(offset, _numRows);
+  for (int r = 0; r < hist; r++) {
+    TermCell* row = view[r];
+    for (int c = 0; c < _numCols; c++) row[c].clear();
+    _scrollback->read(offset - r, _numCols,
+                      [&](int col, uint16_t cp, const TermStyle& st) {
+                        row[col].codepoint = cp;
+                        row[col].style = internStyle(st);
+                      });
+  }
+  for (int r = hist; r < _numRows; r++) {
+    memcpy(view[r], _rowTables[0][r - offset], sizeof(TermCell) * _numCols);
+  }
+  _visible = view;
+  return true;
+}
 
 const TermCell& TermBuffer::cellAt(int row, int col) const {
-  return _cells[row][col];
+  return _visible[row][col];
+}
+
+void TermBuffer::save(StateWriter& w) const {
+  const int cursors[] = {_curRow, _curCol, _savedRow, _savedCol,
+                         _altSavedRow, _altSavedCol, _scrollTop, _scrollBottom};
+  w.u8(_numCols);
+  w.u8(_numRows);
+  for (int v : cursors) w.u8(v);
+  w.u8(_wrapPending | (_altActive << 1));
+  w.u8(_pen.fg);
+  w.u8(_pen.bg);
+  w.u8(_pen.attrs);
+  w.u16(_lastChar);
+
+  // Rows as LineCodec lines, so styles go by value and blanks cost nothing
+  uint8_t line[LineCodec::MAX_BYTES];
+  for (int s = 0; s < 2; s++) {
+    for (int r = 0; r < _numRows; r++) {
+      size_t len = LineCodec::encode(_rowTables[s][r], _numCols, _styles, line);
+      w.u8(_wrapTables[s][r]);
+      w.u16(len);
+      w.write(line, len);
+    }
+  }
+}
+
+bool TermBuffer::restore(StateReader& r) {
+  int cols = r.u8(), rows = r.u8();
+  int cursors[8];
+  for (int& v : cursors) v = r.u8();
+  uint8_t flags = r.u8();
+  if (!r.ok() || cols != _numCols || rows != _numRows) {
+    r.fail();
+    return false;
+  }
+  _curRow = cursors[0];
+  _curCol = cursors[1];
+  _savedRow = std::min(cursors[2], rows - 1);
+  _savedCol = std::min(cursors[3], cols - 1);
+  _altSavedRow = std::min(cursors[4], rows - 1);
+  _altSavedCol = std::min(cursors[5], cols - 1);
+  _wrapPending = flags & 1;
+  _altActive = flags & 2;
+  _pen.fg = r.u8();
+  _pen.bg = r.u8();
+  _pen.attrs = r.u8();
+  _penId = StyleTable::DEFAULT;
+  _penDirty = true;
+  _lastChar = r.u16();
+
+  // Fresh style table: every id is re-interned from the saved values
+  _styles = StyleTable();
+  _viewOffset = 0;
+  for (int s = 0; s < 3; s++) {
+    layoutRows(s);
+    TermCell* cells = pool(s);
+    for (int i = 0; i < cols * rows; i++) cells[i].clear();
+  }
+  uint8_t line[LineCodec::MAX_BYTES];
+  for (int s = 0; s < 2; s++) {
+    for (int row = 0; row < rows; row++) {
+      _wrapTables[s][row] = r.u8();
+      size_t len = r.u16();
+      if (len > sizeof(line)) r.fail();
+      if (!r.ok()) return false;
+      r.bytes(line, len);
+      TermCell* dst = _rowTables[s][row];
+      LineCodec::decode(len, [&](size_t i) { return line[i]; }, cols,
+                        [&](int col, uint16_t cp, const TermStyle& st) {
+                          dst[col].codepoint = cp;
+                          dst[col].style = internStyle(st);
+                        });
+    }
+  }
+  if (!r.ok()) return false;
+
+  _rows = _rowTables[_altActive];
+  _wrapped = _wrapTables[_altActive];
+  _visible = _rows;
+  clampCursor();
+  bool region = cursors[6] < cursors[7] && cursors[7] < rows;
+  _scrollTop = region ? cursors[6] : 0;
+  _scrollBottom = region ? cursors[7] : rows - 1;
+  markAllDirty();
+  return true;
 }
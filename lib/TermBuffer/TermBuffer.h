@@ -1,14 +1,33 @@
 #pragma once
+#include "RowSet.h"
+#include "Scrollback.h"
+#include "StateIO.h"
 #include "TermCell.h"
 #include "term_config.h"
 
 class TermBuffer {
  public:
-  TermBuffer();
+  TermBuffer(int cols, int rows);
+
+  // Change the grid size. Main screen lines are reflowed to the new width
+  // (rows joined by autowrap stay joined) with the cursor kept on the same
+  // character; lines pushed off the top go to the scrollback. The
+  // alternate screen is cropped, its application redraws.
+  void resize(int cols, int rows);
+  int cols() const { return _numCols; }
+  int rows() const { return _numRows; }
 
   // Write character at cursor and advance
   void putChar(uint16_t cp);
 
+  // Write a run of printable ASCII at cursor, filling up to the right
+  // margin per pass and marking each touched row dirty once. If charset
+  // is given, each byte is translated through it (128 entries).
+  void putChars(const uint8_t* s, int n, const uint16_t* charset = nullptr);
+
+  // Repeat the last written character n times (REP)
+  void repeatChar(int n);
+
   // Cursor movement
   void setCursor(int row, int col);
   void moveCursorUp(int n = 1);
@@ -27,6 +46,8 @@ class TermBuffer {
 
   // Scroll
   void setScrollRegion(int top, int bottom);
+  int scrollTop() const { return _scrollTop; }
+  int scrollBottom() const { return _scrollBottom; }
   void scrollUp(int n = 1);
   void scrollDown(int n = 1);
 
@@ -36,6 +57,12 @@ class TermBuffer {
   void insertChars(int n);
   void deleteChars(int n);
 
+  // Rectangular areas: 0-based inclusive bounds, clipped to the screen
+  void fillRect(int top, int left, int bottom, int right, uint16_t cp);  // DECFRA
+  void eraseRect(int top, int left, int bottom, int right);              // DECERA
+  void copyRect(int top, int left, int bottom, int right,
+                int dstTop, int dstLeft);                                // DECCRA
+
   // Cursor save/restore
   void saveCursor();
   void restoreCursor();
@@ -44,43 +71,137 @@ class TermBuffer {
   void switchScreen(bool alt);
   bool isAltScreen() const { return _altActive; }
 
+  // Scrollback: lines scrolled off the top of the main screen are kept
+  // in sb (nullptr = none)
+  void attachScrollback(Scrollback* sb) { _scrollback = sb; }
+
+  // Local scrollback view: move the visible rows delta lines back into
+  // history (negative = towards the live screen; offset 0 = live). Output
+  // keeps updating the live screen underneath. Returns false if the
+  // offset did not change.
+  bool scrollView(int delta);
+  int viewOffset() const { return _viewOffset; }
+
+  // Persist both screens, the cursors, scroll region and pen (not the
+  // scrollback, which saves itself). restore() needs a grid of the same
+  // size; on failure the buffer is left blank and should be reset.
+  void save(StateWriter& w) const;
+  bool restore(StateReader& r);
+
   // Erase characters (ECH)
   void eraseChars(int n);
 
-  // Attributes
+  // Attributes of new characters (the pen); interned on first use
   void setAttr(uint8_t attr);
   void clearAttr(uint8_t attr);
   void resetAttrs();
-  uint8_t currentAttrs() const { return _attrs; }
-  void setBgBright(uint8_t b) { _bgBright = b; }
+  uint8_t currentAttrs() const { return _pen.attrs; }
+  void setFgBright(uint8_t f);
+  void setBgBright(uint8_t b);
+
+  // Style of a cell
+  const TermStyle& style(uint8_t id) const { return _styles[id]; }
 
   // Access
   const TermCell& cellAt(int row, int col) const;
   int cursorRow() const { return _curRow; }
   int cursorCol() const { return _curCol; }
 
-  // Dirty tracking
-  uint32_t dirtyRows() const { return _dirtyRows; }
-  void clearDirty() { _dirtyRows = 0; }
-  void markRowDirty(int row) { _dirtyRows |= (1u << row); }
-  void markAllDirty() { _dirtyRows = (1u << TERM_ROWS) - 1; }
+  // Dirty tracking: a bit per row plus the damaged [min, max] column span
+  // of each dirty row (valid only while the row's bit is set)
+  const RowSet& dirtyRows() const { return _dirtyRows; }
+  int dirtyMinCol(int row) const { return _dirtyMin[row]; }
+  int dirtyMaxCol(int row) const { return _dirtyMax[row]; }
+  void clearDirty() { _dirtyRows.clear(); }
+  void markDirty(int row, int minCol, int maxCol) {
+    if (!_dirtyRows.test(row)) {
+      _dirtyRows.set(row);
+      _dirtyMin[row] = minCol;
+      _dirtyMax[row] = maxCol;
+      return;
+    }
+    if (minCol < _dirtyMin[row]) _dirtyMin[row] = minCol;
+    if (maxCol > _dirtyMax[row]) _dirtyMax[row] = maxCol;
+  }
+  void markRowDirty(int row) { markDirty(row, 0, _numCols - 1); }
+  void markAllDirty() {
+    for (int r = 0; r < _numRows; r++) {
+      _dirtyMin[r] = 0;
+      _dirtyMax[r] = _numCols - 1;
+    }
+    _dirtyRows.setFirst(_numRows);
+    _moveCount = 0;  // nothing left to save by moving
+  }
+
+  // Content moved since the last render, in order, for the renderer to
+  // move the pixels instead of redrawing them. Rows and cells that moved
+  // are not marked dirty; their dirty marks move with them, and only what
+  // a move exposes is. Applying a move where the pixels are stale is
+  // harmless as long as the renderer's record of them moves too.
+  struct Move {
+    bool cells;       // true: cells [col, cols) of row top; false: rows [top, bottom]
+    uint8_t top, bottom, col;
+    int8_t delta;     // rows down or columns right; negative up or left
+  };
+  static constexpr int MAX_MOVES = 8;
+  int moveCount() const { return _moveCount; }
+  const Move& move(int i) const { return _moves[i]; }
+  void clearMoves() { _moveCount = 0; }
 
  private:
-  TermCell _cells[TERM_ROWS][TERM_COLS];
-  TermCell _altCells[TERM_ROWS][TERM_COLS];  // alternate screen buffer
+  int _numCols, _numRows;
+
+  // Cell storage for both screens and the scrollback view, cols x rows of
+  // each pool in use, addressed through row pointer tables so scrolling
+  // rotates pointers and screen switches swap tables. The view's pool is
+  // shared by every buffer: only one (the foreground session) may have its
+  // view open at a time, and resize() borrows it as scratch, so every
+  // buffer's view must be closed before any is resized.
+  TermCell _cellPool[2][TERM_MAX_CELLS];
+  static TermCell _viewPool[TERM_MAX_CELLS];
+  TermCell* _rowTables[3][TERM_MAX_ROWS];  // [0] = main, [1] = alternate, [2] = view
+  TermCell** _rows;                        // active screen's table
+  TermCell** _visible;                     // what cellAt() shows: _rows or the view
+  // Per screen row: line continues on the next row (autowrap), for reflow.
+  // Rotated along with the row pointers.
+  uint8_t _wrapTables[2][TERM_MAX_ROWS];
+  uint8_t* _wrapped;
+  Scrollback* _scrollback = nullptr;
+  int _viewOffset = 0;
   int _curRow = 0, _curCol = 0;
   int _savedRow = 0, _savedCol = 0;
   int _altSavedRow = 0, _altSavedCol = 0;   // cursor saved when entering alt screen
-  int _scrollTop = 0, _scrollBottom = TERM_ROWS - 1;
-  uint8_t _attrs = 0;
-  uint8_t _bgBright = 255;    // current background brightness for new chars
-  uint32_t _dirtyRows = 0;
+  int _scrollTop = 0, _scrollBottom = 0;
+  StyleTable _styles;
+  TermStyle _pen;             // style for new chars
+  uint8_t _penId = StyleTable::DEFAULT;
+  bool _penDirty = false;     // _pen changed since _penId was interned
+  RowSet _dirtyRows;
+  uint8_t _dirtyMin[TERM_MAX_ROWS];
+  uint8_t _dirtyMax[TERM_MAX_ROWS];
+  Move _moves[MAX_MOVES];
+  int _moveCount = 0;
   bool _wrapPending = false;  // deferred wrap: cursor at last col, wrap on next char
   bool _altActive = false;    // currently using alternate screen
+  uint16_t _lastChar = 0;     // last character written, for REP (0 = none)
 
   void clampCursor();
+  TermCell* pool(int screen) { return screen < 2 ? _cellPool[screen] : _viewPool; }
+  void layoutRows(int screen);
+  void copyRowsOut(int screen, TermCell* dst) const;
+  int reflowNewLine(int row, int& cursorRow);
+  void rotateRows(int first, int middle, int last);
+  uint8_t penStyle();
+  uint8_t internStyle(const TermStyle& s);
+  void collectStyles();
+  int beginSpan(int n);
+  void endSpan(int count);
+  bool clipRect(int& top, int& left, int& bottom, int& right) const;
   void clearRow(int row);
   void clearCell(int row, int col);
-  void scrollRegionUp(int top, int bottom, int n);
+  void scrollRegionUp(int top, int bottom, int n, bool toHistory = false);
   void scrollRegionDown(int top, int bottom, int n);
+  void moveRows(int top, int bottom, int delta);
+  void moveCells(int col, int delta);
+  void addMove(const Move& m);
 };
@@ -1,23 +1,19 @@
 #pragma once
 #include <cstdint>
+#include "TermStyle.h"
 
-struct TermCell {
+// Packed to three bytes: the grids are the largest thing in RAM
+struct __attribute__((packed)) TermCell {
   uint16_t codepoint = ' ';
-  uint8_t  attrs     = 0;
-  uint8_t  bgBright  = 255;  // Background brightness: 0=black, 255=white
-
-  static constexpr uint8_t ATTR_BOLD    = 0x01;
-  static constexpr uint8_t ATTR_INVERSE = 0x02;
-  static constexpr uint8_t ATTR_UNDERLINE = 0x04;
+  uint8_t  style     = StyleTable::DEFAULT;  // Index into TermBuffer's style table
 
   void clear() {
     codepoint = ' ';
-    attrs = 0;
-    bgBright = 255;
+    style = StyleTable::DEFAULT;
   }
 
   bool operator==(const TermCell& o) const {
-    return codepoint == o.codepoint && attrs == o.attrs && bgBright == o.bgBright;
+    return codepoint == o.codepoint && style == o.style;
   }
   bool operator!=(const TermCell& o) const { return !(*this == o); }
 };
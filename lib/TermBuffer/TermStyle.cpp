@@ -0,0 +1,42 @@
+#include "TermStyle.h"
+#include <cstring>
+
+StyleTable::StyleTable() {
+  memset(_used, 0, sizeof(_used));
+  memset(_marks, 0, sizeof(_marks));
+  _used[0] = 1;  // DEFAULT
+}
+
+bool StyleTable::intern(const TermStyle& s, uint8_t& id) {
+  if (_styles[_last] == s && isUsed(_last)) {
+    id = _last;
+    return true;
+  }
+  int freeSlot = -1;
+  for (int i = 0; i < _high; i++) {
+    if (!isUsed(i)) {
+      if (freeSlot < 0) freeSlot = i;
+    } else if (_styles[i] == s) {
+      id = _last = i;
+      return true;
+    }
+  }
+  if (freeSlot < 0) {
+    if (_high == MAX_STYLES) return false;
+    freeSlot = _high++;
+  }
+  _styles[freeSlot] = s;
+  _used[freeSlot >> 5] |= 1u << (freeSlot & 31);
+  id = _last = freeSlot;
+  return true;
+}
+
+void StyleTable::beginSweep() {
+  memset(_marks, 0, sizeof(_marks));
+  mark(DEFAULT);
+}
+
+void StyleTable::sweep() {
+  memcpy(_used, _marks, sizeof(_used));
+  while (_high > 1 && !isUsed(_high - 1)) _high--;
+}
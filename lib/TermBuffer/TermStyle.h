@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+// Rendering attributes shared by runs of cells. Cells hold an index into a
+// StyleTable rather than the attributes themselves, so the attribute set can
+// grow without growing the grid.
+struct TermStyle {
+  uint8_t fg    = 0;    // Foreground luminance: 0=black, 255=white
+  uint8_t bg    = 255;  // Background luminance
+  uint8_t attrs = 0;    // ATTR_* bits
+
+  static constexpr uint8_t ATTR_BOLD      = 0x01;
+  static constexpr uint8_t ATTR_INVERSE   = 0x02;
+  static constexpr uint8_t ATTR_UNDERLINE = 0x04;
+  static constexpr uint8_t ATTR_DIM       = 0x08;  // faint
+  static constexpr uint8_t ATTR_ITALIC    = 0x10;
+  static constexpr uint8_t ATTR_STRIKE    = 0x20;
+  static constexpr uint8_t ATTR_BLINK     = 0x40;
+  static constexpr uint8_t ATTR_HIDDEN    = 0x80;
+
+  bool operator==(const TermStyle& o) const {
+    return fg == o.fg && bg == o.bg && attrs == o.attrs;
+  }
+  bool operator!=(const TermStyle& o) const { return !(*this == o); }
+};
+
+// Interned styles addressed by 8-bit id. Id 0 is always the default style.
+// Entries are reclaimed by a mark/sweep pass when the table fills up.
+class StyleTable {
+ public:
+  static constexpr int MAX_STYLES = 256;
+  static constexpr uint8_t DEFAULT = 0;
+
+  StyleTable();
+
+  // Find or add a style; returns false if every entry is in use
+  bool intern(const TermStyle& s, uint8_t& id);
+
+  const TermStyle& operator[](uint8_t id) const { return _styles[id]; }
+
+  // Reclaim entries: beginSweep(), mark() every id still referenced, sweep()
+  void beginSweep();
+  void mark(uint8_t id) { _marks[id >> 5] |= 1u << (id & 31); }
+  void sweep();
+
+ private:
+  TermStyle _styles[MAX_STYLES];
+  uint32_t _used[MAX_STYLES / 32];
+  uint32_t _marks[MAX_STYLES / 32];
+  int _high = 1;      // entries [0, _high) have been handed out at some point
+  uint8_t _last = 0;  // most recent result, checked first
+
+  bool isUsed(int id) const { return _used[id >> 5] & (1u << (id & 31)); }
+};
@@ -0,0 +1,289 @@
+#include "GlyphDraw.h"
+
+namespace GlyphDraw {
+
+// Line weights of the four arms of a box drawing character
+enum Weight : uint8_t { NONE, LIGHT, HEAVY, DOUBLE };
+
+#define ARMS(u, r, d, l) ((u) | (r) << 2 | (d) << 4 | (l) << 6)
+#define L LIGHT
+#define H HEAVY
+#define D DOUBLE
+
+// Arms of U+2500-257F, packed up | right << 2 | down << 4 | left << 6.
+// Dashes and diagonals are 0 here and drawn separately; arcs are drawn
+// as square corners.
+static const uint8_t kBoxArms[128] = {
+    // 2500 ─ ━ │ ┃ ┄ ┅ ┆ ┇ ┈ ┉ ┊ ┋ ┌ ┍ ┎ ┏
+    ARMS(0, L, 0, L), ARMS(0, H, 0, H), ARMS(L, 0, L, 0), ARMS(H, 0, H, 0),
+    0, 0, 0, 0, 0, 0, 0, 0,
+    ARMS(0, L, L, 0), ARMS(0, H, L, 0), ARMS(0, L, H, 0), ARMS(0, H, H, 0),
+    // 2510 ┐ ┑ ┒ ┓ └ ┕ ┖ ┗ ┘ ┙ ┚ ┛ ├ ┝ ┞ ┟
+    ARMS(0, 0, L, L), ARMS(0, 0, L, H), ARMS(0, 0, H, L), ARMS(0, 0, H, H),
+    ARMS(L, L, 0, 0), ARMS(L, H, 0, 0), ARMS(H, L, 0, 0), ARMS(H, H, 0, 0),
+    ARMS(L, 0, 0, L), ARMS(L, 0, 0, H), ARMS(H, 0, 0, L), ARMS(H, 0, 0, H),
+    ARMS(L, L, L, 0), ARMS(L, H, L, 0), ARMS(H, L, L, 0), ARMS(L, L, H, 0),
+    // 2520 ┠ ┡ ┢ ┣ ┤ ┥ ┦ ┧ ┨ ┩ ┪ ┫ ┬ ┭ ┮ ┯
+    ARMS(H, L, H, 0), ARMS(H, H, L, 0), ARMS(L, H, H, 0), ARMS(H, H, H, 0),
+    ARMS(L, 0, L, L), ARMS(L, 0, L, H), ARMS(H, 0, L, L), ARMS(L, 0, H, L),
+    ARMS(H, 0, H, L), ARMS(H, 0, L, H), ARMS(L, 0, H, H), ARMS(H, 0, H, H),
+    ARMS(0, L, L, L), ARMS(0, L, L, H), ARMS(0, H, L, L), ARMS(0, H, L, H),
+    // 2530 ┰ ┱ ┲ ┳ ┴ ┵ ┶ ┷ ┸ ┹ ┺ ┻ ┼ ┽ ┾ ┿
+    ARMS(0, L, H, L), ARMS(0, L, H, H), ARMS(0, H, H, L), ARMS(0, H, H, H),
+    ARMS(L, L, 0, L), ARMS(L, L, 0, H), ARMS(L, H, 0, L), ARMS(L, H, 0, H),
+    ARMS(H, L, 0, L), ARMS(H, L, 0, H), ARMS(H, H, 0, L), ARMS(H, H, 0, H),
+    ARMS(L, L, L, L), ARMS(L, L, L, H), ARMS(L, H, L, L), ARMS(L, H, L, H),
+    // 2540 ╀ ╁ ╂ ╃ ╄ ╅ ╆ ╇ ╈ ╉ ╊ ╋ ╌ ╍ ╎ ╏
+    ARMS(H, L, L, L), ARMS(L, L, H, L), ARMS(H, L, H, L), ARMS(H, L, L, H),
+    ARMS(H, H, L, L), ARMS(L, L, H, H), ARMS(L, H, H, L), ARMS(H, H, L, H),
+    ARMS(L, H, H, H), ARMS(H, L, H, H), ARMS(H, H, H, L), ARMS(H, H, H, H),
+    0, 0, 0, 0,
+    // 2550 ═ ║ ╒ ╓ ╔ ╕ ╖ ╗ ╘ ╙ ╚ ╛ ╜ ╝ ╞ ╟
+    ARMS(0, D, 0, D), ARMS(D, 0, D, 0), ARMS(0, D, L, 0), ARMS(0, L, D, 0),
+    ARMS(0, D, D, 0), ARMS(0, 0, L, D), ARMS(0, 0, D, L), ARMS(0, 0, D, D),
+    ARMS(L, D, 0, 0), ARMS(D, L, 0, 0), ARMS(D, D, 0, 0), ARMS(L, 0, 0, D),
+    ARMS(D, 0, 0, L), ARMS(D, 0, 0, D), ARMS(L, D, L, 0), ARMS(D, L, D, 0),
+    // 2560 ╠ ╡ ╢ ╣ ╤ ╥ ╦ ╧ ╨ ╩ ╪ ╫ ╬ ╭ ╮ ╯
+    ARMS(D, D, D, 0), ARMS(L, 0, L, D), ARMS(D, 0, D, L), ARMS(D, 0, D, D),
+    ARMS(0, D, L, D), ARMS(0, L, D, L), ARMS(0, D, D, D), ARMS(L, D, 0, D),
+    ARMS(D, L, 0, L), ARMS(D, D, 0, D), ARMS(L, D, L, D), ARMS(D, L, D, L),
+    ARMS(D, D, D, D), ARMS(0, L, L, 0), ARMS(0, 0, L, L), ARMS(L, 0, 0, L),
+    // 2570 ╰ ╱ ╲ ╳ ╴ ╵ ╶ ╷ ╸ ╹ ╺ ╻ ╼ ╽ ╾ ╿
+    ARMS(L, L, 0, 0), 0, 0, 0,
+    ARMS(0, 0, 0, L), ARMS(L, 0, 0, 0), ARMS(0, L, 0, 0), ARMS(0, 0, L, 0),
+    ARMS(0, 0, 0, H), ARMS(H, 0, 0, 0), ARMS(0, H, 0, 0), ARMS(0, 0, H, 0),
+    ARMS(0, H, 0, L), ARMS(L, 0, H, 0), ARMS(0, L, 0, H), ARMS(H, 0, L, 0),
+};
+
+#undef ARMS
+#undef L
+#undef H
+#undef D
+
+// Quadrants of U+2596-259F: upper left 1, upper right 2, lower left 4,
+// lower right 8
+static const uint8_t kQuadrants[10] = {4, 8, 1, 13, 9, 7, 11, 2, 6, 14};
+
+// Set the ink of [x0, x1] x [y0, y1], clipped to the cell
+static void fill(uint32_t* rows, int w, int h, int x0, int y0, int x1, int y1) {
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= w) x1 = w - 1;
+  if (y1 >= h) y1 = h - 1;
+  if (x0 > x1) return;
+  uint32_t bits = (~0u >> x0) & (~0u << (31 - x1));
+  for (int y = y0; y <= y1; y++) rows[y] |= bits;
+}
+
+static int halfWidth(uint8_t weight) { return weight >= HEAVY ? 1 : 0; }
+
+// A vertical arm over rows [y0, y1] at column cx. A double arm is two
+// lines beside cx; a line is cut back to [cy0, cy1] where a double arm
+// leaves the centre on its side, which keeps ╔ and ╬ open inside.
+static void vArm(uint32_t* rows, int w, int h, uint8_t weight, int cx, int y0, int y1,
+                 int cy0, int cy1, bool cutLeft, bool cutRight) {
+  switch (weight) {
+    case LIGHT:
+      fill(rows, w, h, cx, y0, cx, y1);
+      break;
+    case HEAVY:
+      fill(rows, w, h, cx - 1, y0, cx + 1, y1);
+      break;
+    case DOUBLE:
+      fill(rows, w, h, cx - 1, cutLeft ? cy0 : y0, cx - 1, cutLeft ? cy1 : y1);
+      fill(rows, w, h, cx + 1, cutRight ? cy0 : y0, cx + 1, cutRight ? cy1 : y1);
+      break;
+  }
+}
+
+// vArm() turned sideways: columns [x0, x1] at row cy
+static void hArm(uint32_t* rows, int w, int h, uint8_t weight, int cy, int x0, int x1,
+                 int cx0, int cx1, bool cutUp, bool cutDown) {
+  switch (weight) {
+    case LIGHT:
+      fill(rows, w, h, x0, cy, x1, cy);
+      break;
+    case HEAVY:
+      fill(rows, w, h, x0, cy - 1, x1, cy + 1);
+      break;
+    case DOUBLE:
+      fill(rows, w, h, cutUp ? cx0 : x0, cy - 1, cutUp ? cx1 : x1, cy - 1);
+      fill(rows, w, h, cutDown ? cx0 : x0, cy + 1, cutDown ? cx1 : x1, cy + 1);
+      break;
+  }
+}
+
+// How far an arm reaches past the centre: the half width of the arms
+// across it (a and b), so corners and tees close up. A lone arm meeting a
+// double line that runs straight through stops at its near line.
+static int reach(uint8_t a, uint8_t b, uint8_t opposite) {
+  if (a == DOUBLE && b == DOUBLE && opposite == NONE) return -1;
+  return halfWidth(a) > halfWidth(b) ? halfWidth(a) : halfWidth(b);
+}
+
+// Lines from the centre to the edges
+static void drawArms(uint8_t arms, int w, int h, uint32_t* rows) {
+  const int cx = (w - 1) / 2, cy = (h - 1) / 2;
+  uint8_t u = arms & 3, r = (arms >> 2) & 3, d = (arms >> 4) & 3, l = arms >> 6;
+  vArm(rows, w, h, u, cx, 0, cy + reach(l, r, d), 0, cy - 1, l == DOUBLE, r == DOUBLE);
+  vArm(rows, w, h, d, cx, cy - reach(l, r, u), h - 1, cy + 1, h - 1, l == DOUBLE, r == DOUBLE);
+  hArm(rows, w, h, l, cy, 0, cx + reach(u, d, r), 0, cx - 1, u == DOUBLE, d == DOUBLE);
+  hArm(rows, w, h, r, cy, cx - reach(u, d, l), w - 1, cx + 1, w - 1, u == DOUBLE, d == DOUBLE);
+}
+
+// A dashed line through the centre: n dashes, each one segment of the
+// cell less a gap
+static void drawDashes(bool vertical, bool heavy, int n, int w, int h, uint32_t* rows) {
+  const int cx = (w - 1) / 2, cy = (h - 1) / 2;
+  const int len = vertical ? h : w;
+  const int t = heavy ? 1 : 0;
+  int gap = len / (n * 3);
+  if (gap < 1) gap = 1;
+  for (int i = 0; i < n; i++) {
+    int a = i * len / n, b = (i + 1) * len / n - 1 - gap;
+    if (vertical) {
+      fill(rows, w, h, cx - t, a, cx + t, b);
+    } else {
+      fill(rows, w, h, a, cy - t, b, cy + t);
+    }
+  }
+}
+
+// One pixel per row: h is at least w, so the line has no gaps
+static void drawDiagonal(bool rising, int w, int h, uint32_t* rows) {
+  for (int y = 0; y < h; y++) {
+    int x = y * (w - 1) / (h - 1);
+    if (rising) x = w - 1 - x;
+    rows[y] |= 0x80000000u >> x;
+  }
+}
+
+// Shade patterns, aligned to the cell so neighbours tile
+static void drawShade(int level, int w, int h, uint32_t* rows) {
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      bool ink;
+      switch (level) {
+        case 1: ink = ((x + 2 * y) & 3) == 0; break;  // ░ 25%
+        case 2: ink = ((x + y) & 1) == 0; break;      // ▒ 50%
+        default: ink = ((x + 2 * y) & 3) != 0; break; // ▓ 75%
+      }
+      if (ink) rows[y] |= 0x80000000u >> x;
+    }
+  }
+}
+
+static void drawBlock(uint16_t cp, int w, int h, uint32_t* rows) {
+  if (cp == 0x2580) {                            // ▀ upper half
+    fill(rows, w, h, 0, 0, w - 1, h / 2 - 1);
+  } else if (cp <= 0x2588) {                     // ▁ to █ lower eighths
+    int n = cp - 0x2580;
+    fill(rows, w, h, 0, h - (n * h + 4) / 8, w - 1, h - 1);
+  } else if (cp <= 0x258F) {                     // ▉ to ▏ left eighths
+    int n = 0x2590 - cp;
+    fill(rows, w, h, 0, 0, (n * w + 4) / 8 - 1, h - 1);
+  } else if (cp == 0x2590) {                     // ▐ right half
+    fill(rows, w, h, w / 2, 0, w - 1, h - 1);
+  } else if (cp <= 0x2593) {                     // ░ ▒ ▓
+    drawShade(cp - 0x2590, w, h, rows);
+  } else if (cp == 0x2594) {                     // ▔ upper eighth
+    fill(rows, w, h, 0, 0, w - 1, (h + 4) / 8 - 1);
+  } else if (cp == 0x2595) {                     // ▕ right eighth
+    fill(rows, w, h, w - (w + 4) / 8, 0, w - 1, h - 1);
+  } else {                                       // ▖ to ▟ quadrants
+    uint8_t q = kQuadrants[cp - 0x2596];
+    const int mx = w / 2, my = h / 2;
+    if (q & 1) fill(rows, w, h, 0, 0, mx - 1, my - 1);
+    if (q & 2) fill(rows, w, h, mx, 0, w - 1, my - 1);
+    if (q & 4) fill(rows, w, h, 0, my, mx - 1, h - 1);
+    if (q & 8) fill(rows, w, h, mx, my, w - 1, h - 1);
+  }
+}
+
+// Dots 1-3 and 7 run down the left column, 4-6 and 8 down the right; the
+// low bits of the codepoint are the raised dots in that order
+static void drawBraille(uint8_t dots, int w, int h, uint32_t* rows) {
+  static const uint8_t kDot[8][2] = {  // column, row of each bit
+      {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}, {0, 3}, {1, 3},
+  };
+  int size = (w + 2) / 5;
+  if (size < 1) size = 1;
+  const int cellW = w / 2, cellH = h / 4;
+  for (int bit = 0; bit < 8; bit++) {
+    if (!(dots & (1 << bit))) continue;
+    int x = kDot[bit][0] * cellW + (cellW - size) / 2;
+    int y = kDot[bit][1] * cellH + (cellH - size) / 2;
+    fill(rows, w, h, x, y, x + size - 1, y + size - 1);
+  }
+}
+
+// 3x5 capitals for the control pictures, three bits per row from the top
+static uint16_t tinyLetter(char c) {
+  switch (c) {
+    case 'C': return 0b011'100'100'100'011;
+    case 'F': return 0b111'100'110'100'100;
+    case 'H': return 0b101'101'111'101'101;
+    case 'L': return 0b100'100'100'100'111;
+    case 'N': return 0b101'111'111'101'101;
+    case 'R': return 0b110'101'110'101'101;
+    case 'T': return 0b111'010'010'010'010;
+    case 'V': return 0b101'101'101'101'010;
+    default: return 0;
+  }
+}
+
+// A control picture as the VT100 shows it: the two letters of the
+// control's name, the first high on the left, the second low on the right
+static void drawControlPicture(const char* name, int w, int h, uint32_t* rows) {
+  int s = w / 7 < h / 11 ? w / 7 : h / 11;
+  if (s < 1) s = 1;
+  const int x0 = (w - 7 * s) / 2, y0 = (h - 11 * s) / 2;
+  for (int i = 0; i < 2; i++) {
+    uint16_t bits = tinyLetter(name[i]);
+    int lx = x0 + i * 4 * s, ly = y0 + i * 6 * s;
+    for (int bit = 0; bit < 15; bit++) {
+      if (!(bits >> (14 - bit) & 1)) continue;
+      int x = lx + bit % 3 * s, y = ly + bit / 3 * s;
+      fill(rows, w, h, x, y, x + s - 1, y + s - 1);
+    }
+  }
+}
+
+bool draw(uint16_t cp, int w, int h, uint32_t* rows) {
+  bool box = cp >= 0x2500 && cp <= 0x257F;
+  bool block = cp >= 0x2580 && cp <= 0x259F;
+  bool braille = cp >= 0x2800 && cp <= 0x28FF;
+  bool scan = cp >= 0x23BA && cp <= 0x23BD;
+  bool control = (cp >= 0x2409 && cp <= 0x240D) || cp == 0x2424;
+  if (!box && !block && !braille && !scan && !control) return false;
+
+  for (int y = 0; y < h; y++) rows[y] = 0;
+  if (control) {
+    // ␉ ␊ ␋ ␌ ␍, ␤
+    static const char* const kNames[5] = {"HT", "LF", "VT", "FF", "CR"};
+    drawControlPicture(cp == 0x2424 ? "NL" : kNames[cp - 0x2409], w, h, rows);
+  } else if (braille) {
+    drawBraille(cp & 0xFF, w, h, rows);
+  } else if (block) {
+    drawBlock(cp, w, h, rows);
+  } else if (scan) {
+    // ⎺ ⎻ ⎼ ⎽: scan lines 1, 3, 7 and 9 of nine
+    static const uint8_t kScanLine[4] = {0, 2, 6, 8};
+    int y = kScanLine[cp - 0x23BA] * (h - 1) / 8;
+    fill(rows, w, h, 0, y, w - 1, y);
+  } else if (cp >= 0x2504 && cp <= 0x250B) {  // ┄ to ┋
+    int i = cp - 0x2504;
+    drawDashes(i & 2, i & 1, i < 4 ? 3 : 4, w, h, rows);
+  } else if (cp >= 0x254C && cp <= 0x254F) {  // ╌ to ╏
+    int i = cp - 0x254C;
+    drawDashes(i & 2, i & 1, 2, w, h, rows);
+  } else if (cp >= 0x2571 && cp <= 0x2573) {  // ╱ ╲ ╳
+    if (cp != 0x2572) drawDiagonal(true, w, h, rows);
+    if (cp != 0x2571) drawDiagonal(false, w, h, rows);
+  } else {
+    drawArms(kBoxArms[cp - 0x2500], w, h, rows);
+  }
+  return true;
+}
+
+}  // namespace GlyphDraw
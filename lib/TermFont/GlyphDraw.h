@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+// Glyphs drawn from geometry instead of a font: box drawing (U+2500-257F),
+// block elements and quadrants (U+2580-259F), Braille (U+2800-28FF) and
+// the DEC scan lines (U+23BA-23BD). They tile seamlessly at any cell size,
+// which font bitmaps rarely do. The control pictures of DEC Special
+// Graphics (U+2409-240D, U+2424) are drawn here too: the font has none.
+namespace GlyphDraw {
+
+// Draw cp into a w x h cell as MSB-first ink rows (bit set = ink).
+// Returns false, leaving rows untouched, if cp is not drawn here.
+bool draw(uint16_t cp, int w, int h, uint32_t* rows);
+
+}  // namespace GlyphDraw
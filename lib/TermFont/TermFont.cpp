@@ -0,0 +1,58 @@
+#include "TermFont.h"
+#include "term_font_10x20.h"
+#include "term_font_8x16.h"
+#include "term_font_ext_10x20.h"
+#include "term_font_ext_8x16.h"
+#include "GlyphDraw.h"
+
+namespace TermFont {
+
+static const Face kFaces[FONT_COUNT] = {
+    {TermFont10x20::FONT_W, TermFont10x20::FONT_H, TermFont10x20::BYTES_PER_ROW,
+     TermFont10x20::BYTES_PER_GLYPH, TermFont10x20::glyphs, "10x20", TermFontExt10x20::lookup},
+    {TermFont8x16::FONT_W, TermFont8x16::FONT_H, TermFont8x16::BYTES_PER_ROW,
+     TermFont8x16::BYTES_PER_GLYPH, TermFont8x16::glyphs, "8x16", TermFontExt8x16::lookup},
+};
+
+// All generated fonts share the ASCII range
+static_assert(TermFont10x20::FIRST_CHAR == TermFont8x16::FIRST_CHAR &&
+              TermFont10x20::LAST_CHAR == TermFont8x16::LAST_CHAR, "font ranges differ");
+
+static_assert(TermFont10x20::FONT_W <= MAX_WIDTH && TermFont10x20::FONT_H <= MAX_HEIGHT &&
+              TermFont8x16::FONT_W <= MAX_WIDTH && TermFont8x16::FONT_H <= MAX_HEIGHT,
+              "cell too large for the renderer");
+
+// Each face's extended glyphs are rendered for its own cell
+static_assert(TermFontExt10x20::FONT_W == TermFont10x20::FONT_W &&
+              TermFontExt10x20::FONT_H == TermFont10x20::FONT_H &&
+              TermFontExt10x20::BYTES_PER_GLYPH == TermFont10x20::BYTES_PER_GLYPH &&
+              TermFontExt8x16::FONT_W == TermFont8x16::FONT_W &&
+              TermFontExt8x16::FONT_H == TermFont8x16::FONT_H &&
+              TermFontExt8x16::BYTES_PER_GLYPH == TermFont8x16::BYTES_PER_GLYPH,
+              "extended font cell differs");
+
+bool Face::render(uint16_t cp, uint32_t* rows) const {
+  const uint8_t* src = nullptr;
+  if (cp >= TermFont10x20::FIRST_CHAR && cp <= TermFont10x20::LAST_CHAR) {
+    src = &glyphs[(cp - TermFont10x20::FIRST_CHAR) * bytesPerGlyph];
+  } else if (GlyphDraw::draw(cp, width, height, rows)) {
+    return true;
+  } else if (ext) {
+    src = ext(cp);
+  }
+  if (!src) src = &glyphs[('?' - TermFont10x20::FIRST_CHAR) * bytesPerGlyph];
+
+  for (int y = 0; y < height; y++, src += bytesPerRow) {
+    uint32_t ink = (uint32_t)pgm_read_byte(&src[0]) << 24;
+    if (bytesPerRow > 1) ink |= (uint32_t)pgm_read_byte(&src[1]) << 16;
+    rows[y] = ink;
+  }
+  return false;
+}
+
+const Face& face(uint8_t id) {
+  if (id >= FONT_COUNT) id = FONT_10X20;
+  return kFaces[id];
+}
+
+}  // namespace TermFont
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+// Built-in bitmap fonts. Each cell size comes from its own generated
+// header (scripts/generate_term_font.py); the renderer picks one at runtime.
+namespace TermFont {
+
+// Largest cell the renderer's word blitter handles (bytesPerRow <= 2)
+constexpr int MAX_WIDTH = 16;
+constexpr int MAX_HEIGHT = 24;
+
+struct Face {
+  uint8_t width;
+  uint8_t height;
+  uint8_t bytesPerRow;
+  uint8_t bytesPerGlyph;
+  const uint8_t* glyphs;  // PROGMEM, ASCII 0x20-0x7E
+  const char* name;
+  // Pre-rendered glyph beyond ASCII (PROGMEM), nullptr if none
+  const uint8_t* (*ext)(uint16_t cp);
+
+  // Ink of a character as MSB-first rows, one per pixel row. Resolved in
+  // order: ASCII, glyphs drawn from geometry (GlyphDraw), the extended
+  // font's page table, '?'. Returns true for a drawn glyph: it tiles with
+  // its neighbours, so must not be slanted.
+  bool render(uint16_t cp, uint32_t* rows) const;
+};
+
+enum Id : uint8_t {
+  FONT_10X20,
+  FONT_8X16,
+  FONT_COUNT,
+};
+
+const Face& face(uint8_t id);
+
+}  // namespace TermFont
@@ -11,7 +11,7 @@
 #include <cstdint>
 #include <pgmspace.h>
 
-namespace TermFont {
+namespace TermFont10x20 {
 
 static constexpr uint8_t FONT_W = 10;
 static constexpr uint8_t FONT_H = 20;
@@ -409,4 +409,4 @@ inline const uint8_t* getGlyph(uint8_t c) {
     return &glyphs[(c - FIRST_CHAR) * BYTES_PER_GLYPH];
 }
 
-} // namespace TermFont
+} // namespace TermFont10x20
@@ -0,0 +1,222 @@
+/**
+ * Auto-generated fixed-width terminal font
+ * Source: DejaVuSansMono.ttf
+ * PT size: 13
+ * Cell: 8x16
+ * Characters: 95 (ASCII 0x20-0x7E)
+ * Total bitmap: 1520 bytes (PROGMEM)
+ */
+#pragma once
+
+#include <cstdint>
+#include <pgmspace.h>
+
+namespace TermFont8x16 {
+
+static constexpr uint8_t FONT_W = 8;
+static constexpr uint8_t FONT_H = 16;
+static constexpr uint8_t BYTES_PER_ROW = 1;
+static constexpr uint8_t BYTES_PER_GLYPH = 16;
+static constexpr uint8_t FIRST_CHAR = 0x20;
+static constexpr uint8_t LAST_CHAR = 0x7E;
+static constexpr uint8_t NUM_CHARS = 95;
+
+static const uint8_t glyphs[1520] PROGMEM = {
+    // 0x20 ' '
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x21 '!'
+    0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x10,0x10,0x00,0x00,0x00,0x00,
+    // 0x22 '"'
+    0x00,0x00,0x00,0x28,0x28,0x28,0x28,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x23 '#'
+    0x00,0x00,0x12,0x12,0x16,0x7F,0x24,0x24,0xFE,0x28,0x48,0x48,0x00,0x00,0x00,0x00,
+    // 0x24 '$'
+    0x00,0x00,0x00,0x08,0x3E,0x49,0x48,0x38,0x0E,0x09,0x49,0x3E,0x08,0x08,0x00,0x00,
+    // 0x25 '%'
+    0x00,0x00,0x00,0x60,0x90,0x90,0x62,0x1C,0x66,0x09,0x09,0x06,0x00,0x00,0x00,0x00,
+    // 0x26 '&'
+    0x00,0x00,0x00,0x1C,0x20,0x20,0x30,0x49,0x4D,0x45,0x62,0x3D,0x00,0x00,0x00,0x00,
+    // 0x27 '''
+    0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x28 '('
+    0x00,0x0C,0x08,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x08,0x08,0x04,0x00,0x00,0x00,
+    // 0x29 ')'
+    0x00,0x30,0x10,0x10,0x08,0x08,0x08,0x08,0x08,0x08,0x10,0x10,0x30,0x00,0x00,0x00,
+    // 0x2A '*'
+    0x00,0x00,0x00,0x08,0x49,0x3E,0x1C,0x6B,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x2B '+'
+    0x00,0x00,0x00,0x00,0x10,0x10,0x10,0xFE,0x10,0x10,0x10,0x00,0x00,0x00,0x00,0x00,
+    // 0x2C ','
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x10,0x20,0x00,0x00,
+    // 0x2D '-'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x2E '.'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,
+    // 0x2F '/'
+    0x00,0x00,0x00,0x02,0x04,0x04,0x08,0x08,0x18,0x10,0x10,0x20,0x20,0x40,0x00,0x00,
+    // 0x30 '0'
+    0x00,0x00,0x00,0x1C,0x22,0x41,0x41,0x49,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // 0x31 '1'
+    0x00,0x00,0x00,0x38,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x3E,0x00,0x00,0x00,0x00,
+    // 0x32 '2'
+    0x00,0x00,0x00,0x3E,0x43,0x01,0x01,0x02,0x0C,0x18,0x20,0x7F,0x00,0x00,0x00,0x00,
+    // 0x33 '3'
+    0x00,0x00,0x00,0x3E,0x41,0x01,0x03,0x1C,0x03,0x01,0x43,0x3E,0x00,0x00,0x00,0x00,
+    // 0x34 '4'
+    0x00,0x00,0x00,0x06,0x0A,0x1A,0x12,0x22,0x42,0x7F,0x02,0x02,0x00,0x00,0x00,0x00,
+    // 0x35 '5'
+    0x00,0x00,0x00,0x7E,0x40,0x40,0x7C,0x03,0x01,0x01,0x43,0x3C,0x00,0x00,0x00,0x00,
+    // 0x36 '6'
+    0x00,0x00,0x00,0x1E,0x21,0x40,0x5E,0x63,0x41,0x41,0x23,0x1E,0x00,0x00,0x00,0x00,
+    // 0x37 '7'
+    0x00,0x00,0x00,0x7F,0x02,0x02,0x04,0x04,0x08,0x18,0x10,0x20,0x00,0x00,0x00,0x00,
+    // 0x38 '8'
+    0x00,0x00,0x00,0x3E,0x41,0x41,0x41,0x3E,0x63,0x41,0x61,0x3E,0x00,0x00,0x00,0x00,
+    // 0x39 '9'
+    0x00,0x00,0x00,0x3C,0x62,0x41,0x41,0x63,0x3D,0x01,0x42,0x3C,0x00,0x00,0x00,0x00,
+    // 0x3A ':'
+    0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,
+    // 0x3B ';'
+    0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x10,0x20,0x00,0x00,
+    // 0x3C '<'
+    0x00,0x00,0x00,0x00,0x00,0x01,0x0E,0x70,0x70,0x0E,0x01,0x00,0x00,0x00,0x00,0x00,
+    // 0x3D '='
+    0x00,0x00,0x00,0x00,0x00,0x00,0x7F,0x00,0x00,0x7F,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x3E '>'
+    0x00,0x00,0x00,0x00,0x00,0x40,0x38,0x07,0x07,0x38,0x40,0x00,0x00,0x00,0x00,0x00,
+    // 0x3F '?'
+    0x00,0x00,0x00,0x38,0x44,0x04,0x08,0x10,0x10,0x00,0x10,0x10,0x00,0x00,0x00,0x00,
+    // 0x40 '@'
+    0x00,0x00,0x00,0x1E,0x33,0x21,0x47,0x49,0x49,0x49,0x47,0x20,0x30,0x1E,0x00,0x00,
+    // 0x41 'A'
+    0x00,0x00,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // 0x42 'B'
+    0x00,0x00,0x00,0x7E,0x41,0x41,0x41,0x7E,0x41,0x41,0x41,0x7E,0x00,0x00,0x00,0x00,
+    // 0x43 'C'
+    0x00,0x00,0x00,0x1E,0x21,0x40,0x40,0x40,0x40,0x40,0x21,0x1E,0x00,0x00,0x00,0x00,
+    // 0x44 'D'
+    0x00,0x00,0x00,0x7C,0x42,0x41,0x41,0x41,0x41,0x41,0x42,0x7C,0x00,0x00,0x00,0x00,
+    // 0x45 'E'
+    0x00,0x00,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // 0x46 'F'
+    0x00,0x00,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x40,0x00,0x00,0x00,0x00,
+    // 0x47 'G'
+    0x00,0x00,0x00,0x1E,0x21,0x40,0x40,0x43,0x41,0x41,0x21,0x1E,0x00,0x00,0x00,0x00,
+    // 0x48 'H'
+    0x00,0x00,0x00,0x41,0x41,0x41,0x41,0x7F,0x41,0x41,0x41,0x41,0x00,0x00,0x00,0x00,
+    // 0x49 'I'
+    0x00,0x00,0x00,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // 0x4A 'J'
+    0x00,0x00,0x00,0x1C,0x04,0x04,0x04,0x04,0x04,0x04,0x44,0x38,0x00,0x00,0x00,0x00,
+    // 0x4B 'K'
+    0x00,0x00,0x00,0x42,0x44,0x48,0x50,0x70,0x48,0x44,0x44,0x42,0x00,0x00,0x00,0x00,
+    // 0x4C 'L'
+    0x00,0x00,0x00,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // 0x4D 'M'
+    0x00,0x00,0x00,0x63,0x63,0x55,0x55,0x55,0x49,0x41,0x41,0x41,0x00,0x00,0x00,0x00,
+    // 0x4E 'N'
+    0x00,0x00,0x00,0x61,0x61,0x51,0x51,0x49,0x45,0x45,0x43,0x43,0x00,0x00,0x00,0x00,
+    // 0x4F 'O'
+    0x00,0x00,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // 0x50 'P'
+    0x00,0x00,0x00,0x7E,0x43,0x41,0x41,0x43,0x7E,0x40,0x40,0x40,0x00,0x00,0x00,0x00,
+    // 0x51 'Q'
+    0x00,0x00,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x23,0x1E,0x06,0x02,0x00,0x00,
+    // 0x52 'R'
+    0x00,0x00,0x00,0x7E,0x43,0x41,0x41,0x7E,0x42,0x41,0x41,0x40,0x00,0x00,0x00,0x00,
+    // 0x53 'S'
+    0x00,0x00,0x00,0x3E,0x61,0x40,0x60,0x3E,0x03,0x01,0x43,0x3E,0x00,0x00,0x00,0x00,
+    // 0x54 'T'
+    0x00,0x00,0x00,0xFE,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // 0x55 'U'
+    0x00,0x00,0x00,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x3E,0x00,0x00,0x00,0x00,
+    // 0x56 'V'
+    0x00,0x00,0x00,0x41,0x63,0x22,0x22,0x22,0x14,0x14,0x14,0x08,0x00,0x00,0x00,0x00,
+    // 0x57 'W'
+    0x00,0x00,0x00,0x81,0x81,0x81,0x5A,0x5A,0x5A,0x66,0x66,0x66,0x00,0x00,0x00,0x00,
+    // 0x58 'X'
+    0x00,0x00,0x00,0x63,0x22,0x14,0x1C,0x08,0x14,0x36,0x22,0x41,0x00,0x00,0x00,0x00,
+    // 0x59 'Y'
+    0x00,0x00,0x00,0x82,0x44,0x28,0x28,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // 0x5A 'Z'
+    0x00,0x00,0x00,0x7F,0x03,0x06,0x04,0x08,0x10,0x30,0x60,0x7F,0x00,0x00,0x00,0x00,
+    // 0x5B '['
+    0x00,0x1C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x1C,0x00,0x00,0x00,
+    // 0x5C '<backslash>'
+    0x00,0x00,0x00,0x40,0x20,0x20,0x10,0x10,0x18,0x08,0x08,0x04,0x04,0x02,0x00,0x00,
+    // 0x5D ']'
+    0x00,0x38,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x38,0x00,0x00,0x00,
+    // 0x5E '^'
+    0x00,0x00,0x00,0x10,0x28,0x44,0xC6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x5F '_'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,
+    // 0x60 '`'
+    0x00,0x00,0x10,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // 0x61 'a'
+    0x00,0x00,0x00,0x00,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // 0x62 'b'
+    0x00,0x40,0x40,0x40,0x40,0x7C,0x66,0x42,0x42,0x42,0x66,0x7C,0x00,0x00,0x00,0x00,
+    // 0x63 'c'
+    0x00,0x00,0x00,0x00,0x00,0x1C,0x22,0x40,0x40,0x40,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // 0x64 'd'
+    0x00,0x02,0x02,0x02,0x02,0x3E,0x66,0x42,0x42,0x42,0x66,0x3E,0x00,0x00,0x00,0x00,
+    // 0x65 'e'
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x66,0x42,0x7E,0x40,0x62,0x3C,0x00,0x00,0x00,0x00,
+    // 0x66 'f'
+    0x00,0x0C,0x10,0x10,0x10,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // 0x67 'g'
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x66,0x42,0x42,0x42,0x66,0x3A,0x02,0x22,0x1C,0x00,
+    // 0x68 'h'
+    0x00,0x40,0x40,0x40,0x40,0x5C,0x62,0x42,0x42,0x42,0x42,0x42,0x00,0x00,0x00,0x00,
+    // 0x69 'i'
+    0x00,0x10,0x00,0x00,0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // 0x6A 'j'
+    0x00,0x08,0x00,0x00,0x00,0x38,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x70,0x00,
+    // 0x6B 'k'
+    0x00,0x40,0x40,0x40,0x40,0x44,0x48,0x50,0x70,0x48,0x44,0x42,0x00,0x00,0x00,0x00,
+    // 0x6C 'l'
+    0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x0E,0x00,0x00,0x00,0x00,
+    // 0x6D 'm'
+    0x00,0x00,0x00,0x00,0x00,0x7F,0x49,0x49,0x49,0x49,0x49,0x49,0x00,0x00,0x00,0x00,
+    // 0x6E 'n'
+    0x00,0x00,0x00,0x00,0x00,0x5C,0x62,0x42,0x42,0x42,0x42,0x42,0x00,0x00,0x00,0x00,
+    // 0x6F 'o'
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // 0x70 'p'
+    0x00,0x00,0x00,0x00,0x00,0x7C,0x66,0x42,0x42,0x42,0x66,0x7C,0x40,0x40,0x40,0x00,
+    // 0x71 'q'
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x66,0x42,0x42,0x42,0x66,0x3A,0x02,0x02,0x02,0x00,
+    // 0x72 'r'
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x32,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0x00,
+    // 0x73 's'
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x42,0x40,0x3C,0x02,0x42,0x3C,0x00,0x00,0x00,0x00,
+    // 0x74 't'
+    0x00,0x00,0x00,0x10,0x10,0x7E,0x10,0x10,0x10,0x10,0x10,0x0E,0x00,0x00,0x00,0x00,
+    // 0x75 'u'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // 0x76 'v'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x66,0x24,0x24,0x3C,0x18,0x18,0x00,0x00,0x00,0x00,
+    // 0x77 'w'
+    0x00,0x00,0x00,0x00,0x00,0x81,0x81,0x5A,0x5A,0x5A,0x24,0x24,0x00,0x00,0x00,0x00,
+    // 0x78 'x'
+    0x00,0x00,0x00,0x00,0x00,0x66,0x24,0x18,0x18,0x18,0x24,0x66,0x00,0x00,0x00,0x00,
+    // 0x79 'y'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x22,0x24,0x24,0x14,0x18,0x08,0x08,0x10,0x30,0x00,
+    // 0x7A 'z'
+    0x00,0x00,0x00,0x00,0x00,0x7E,0x02,0x04,0x18,0x20,0x40,0x7E,0x00,0x00,0x00,0x00,
+    // 0x7B '{'
+    0x00,0x1C,0x10,0x10,0x10,0x10,0x60,0x10,0x10,0x10,0x10,0x10,0x0C,0x00,0x00,0x00,
+    // 0x7C '|'
+    0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x00,
+    // 0x7D '}'
+    0x00,0x70,0x10,0x10,0x10,0x10,0x0C,0x10,0x10,0x10,0x10,0x10,0x60,0x00,0x00,0x00,
+    // 0x7E '~'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x39,0x46,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+};
+
+inline const uint8_t* getGlyph(uint8_t c) {
+    if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+    return &glyphs[(c - FIRST_CHAR) * BYTES_PER_GLYPH];
+}
+
+} // namespace TermFont8x16
@@ -0,0 +1,449 @@
+/**
+ * Auto-generated extended Unicode font glyphs
+ * Source: DejaVuSansMono.ttf, PT size: 13
+ * Cell: 8x16
+ * Total: 135 glyphs, 2160 bytes + 3328 bytes page table (PROGMEM)
+ *
+ * Ranges:
+ *   U+00A0-U+00FF (96 glyphs)
+ *   U+03C0-U+03C0 (1 glyphs)
+ *   U+2010-U+2027 (24 glyphs)
+ *   U+2190-U+2199 (10 glyphs)
+ *   U+2260-U+2260 (1 glyphs)
+ *   U+2264-U+2265 (2 glyphs)
+ *   U+25C6-U+25C6 (1 glyphs)
+ */
+#pragma once
+
+#include <cstdint>
+#include <pgmspace.h>
+
+namespace TermFontExt8x16 {
+
+static constexpr uint8_t FONT_W = 8;
+static constexpr uint8_t FONT_H = 16;
+static constexpr uint8_t BYTES_PER_GLYPH = 16;
+static constexpr uint16_t GLYPH_COUNT = 135;
+static constexpr uint8_t PAGE_COUNT = 6;
+static constexpr uint8_t NO_PAGE = 0xFF;
+static constexpr uint16_t NO_GLYPH = 0xFFFF;
+
+// Glyph bitmaps in codepoint order
+static const uint8_t glyphs[2160] PROGMEM = {
+    // U+00A0 ' '
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00A1 '¡'
+    0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x00,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x00,
+    // U+00A2 '¢'
+    0x00,0x00,0x00,0x10,0x10,0x38,0x54,0x50,0x50,0x50,0x54,0x38,0x10,0x10,0x00,0x00,
+    // U+00A3 '£'
+    0x00,0x00,0x00,0x1C,0x20,0x20,0x20,0x78,0x20,0x20,0x20,0xFC,0x00,0x00,0x00,0x00,
+    // U+00A4 '¤'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x3C,0x24,0x24,0x3C,0x42,0x00,0x00,0x00,0x00,0x00,
+    // U+00A5 '¥'
+    0x00,0x00,0x00,0x82,0x44,0x28,0xEE,0x10,0xFE,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // U+00A6 '¦'
+    0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x00,
+    // U+00A7 '§'
+    0x00,0x00,0x00,0x3C,0x40,0x60,0x58,0x4C,0x64,0x34,0x0C,0x04,0x78,0x00,0x00,0x00,
+    // U+00A8 '¨'
+    0x00,0x00,0x28,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00A9 '©'
+    0x00,0x00,0x00,0x3C,0x42,0x9D,0xA1,0xA1,0x9D,0x42,0x3C,0x00,0x00,0x00,0x00,0x00,
+    // U+00AA 'ª'
+    0x00,0x00,0x00,0x3C,0x02,0x1E,0x22,0x3E,0x00,0x3E,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00AB '«'
+    0x00,0x00,0x00,0x00,0x00,0x12,0x36,0x6C,0x6C,0x36,0x12,0x00,0x00,0x00,0x00,0x00,
+    // U+00AC '¬'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7F,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00AD '­'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00AE '®'
+    0x00,0x00,0x00,0x3C,0x42,0xBD,0xA5,0xB9,0xAD,0x42,0x3C,0x00,0x00,0x00,0x00,0x00,
+    // U+00AF '¯'
+    0x00,0x00,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B0 '°'
+    0x00,0x00,0x00,0x18,0x24,0x24,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B1 '±'
+    0x00,0x00,0x00,0x00,0x00,0x10,0x10,0xFE,0x10,0x10,0x00,0xFE,0x00,0x00,0x00,0x00,
+    // U+00B2 '²'
+    0x00,0x00,0x00,0x3C,0x04,0x08,0x10,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B3 '³'
+    0x00,0x00,0x00,0x3C,0x04,0x18,0x04,0x3C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B4 '´'
+    0x00,0x00,0x08,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B5 'µ'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x7F,0x40,0x40,0x40,0x00,
+    // U+00B6 '¶'
+    0x00,0x00,0x00,0x3F,0x7D,0x7D,0x7D,0x1D,0x05,0x05,0x05,0x05,0x05,0x00,0x00,0x00,
+    // U+00B7 '·'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00B8 '¸'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x38,0x00,
+    // U+00B9 '¹'
+    0x00,0x00,0x00,0x18,0x08,0x08,0x08,0x1C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00BA 'º'
+    0x00,0x00,0x00,0x1C,0x22,0x22,0x22,0x1C,0x00,0x3E,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+00BB '»'
+    0x00,0x00,0x00,0x00,0x00,0x48,0x6C,0x36,0x36,0x6C,0x48,0x00,0x00,0x00,0x00,0x00,
+    // U+00BC '¼'
+    0x00,0x00,0x60,0x20,0x20,0x20,0x76,0x38,0xC0,0x04,0x0C,0x14,0x1E,0x04,0x00,0x00,
+    // U+00BD '½'
+    0x00,0x00,0x60,0x20,0x20,0x20,0x76,0x38,0xC0,0x1E,0x02,0x04,0x08,0x1E,0x00,0x00,
+    // U+00BE '¾'
+    0x00,0x00,0x78,0x08,0x30,0x08,0x7E,0x38,0xC0,0x04,0x0C,0x14,0x1E,0x04,0x00,0x00,
+    // U+00BF '¿'
+    0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x00,0x10,0x10,0x30,0x60,0x40,0x44,0x38,0x00,
+    // U+00C0 'À'
+    0x10,0x08,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // U+00C1 'Á'
+    0x04,0x08,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // U+00C2 'Â'
+    0x08,0x14,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // U+00C3 'Ã'
+    0x3A,0x2E,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // U+00C4 'Ä'
+    0x00,0x14,0x00,0x08,0x14,0x14,0x14,0x22,0x22,0x3E,0x63,0x41,0x00,0x00,0x00,0x00,
+    // U+00C5 'Å'
+    0x1C,0x14,0x14,0x08,0x08,0x14,0x14,0x14,0x22,0x3E,0x22,0x41,0x00,0x00,0x00,0x00,
+    // U+00C6 'Æ'
+    0x00,0x00,0x00,0x3E,0x28,0x28,0x28,0x4E,0x48,0x78,0x88,0x8E,0x00,0x00,0x00,0x00,
+    // U+00C7 'Ç'
+    0x00,0x00,0x00,0x1E,0x21,0x40,0x40,0x40,0x40,0x40,0x21,0x1E,0x04,0x04,0x1C,0x00,
+    // U+00C8 'È'
+    0x20,0x10,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // U+00C9 'É'
+    0x08,0x10,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // U+00CA 'Ê'
+    0x18,0x24,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // U+00CB 'Ë'
+    0x00,0x14,0x00,0x7F,0x40,0x40,0x40,0x7F,0x40,0x40,0x40,0x7F,0x00,0x00,0x00,0x00,
+    // U+00CC 'Ì'
+    0x20,0x10,0x00,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00CD 'Í'
+    0x08,0x10,0x00,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00CE 'Î'
+    0x10,0x28,0x00,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00CF 'Ï'
+    0x00,0x28,0x00,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00D0 'Ð'
+    0x00,0x00,0x00,0x7C,0x42,0x41,0x41,0xF1,0x41,0x41,0x42,0x7C,0x00,0x00,0x00,0x00,
+    // U+00D1 'Ñ'
+    0x3A,0x2E,0x00,0x61,0x61,0x51,0x51,0x49,0x45,0x45,0x43,0x43,0x00,0x00,0x00,0x00,
+    // U+00D2 'Ò'
+    0x10,0x08,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // U+00D3 'Ó'
+    0x04,0x08,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // U+00D4 'Ô'
+    0x08,0x14,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // U+00D5 'Õ'
+    0x3A,0x2E,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // U+00D6 'Ö'
+    0x00,0x14,0x00,0x1C,0x22,0x41,0x41,0x41,0x41,0x41,0x22,0x1C,0x00,0x00,0x00,0x00,
+    // U+00D7 '×'
+    0x00,0x00,0x00,0x00,0x00,0x42,0x24,0x18,0x18,0x24,0x42,0x00,0x00,0x00,0x00,0x00,
+    // U+00D8 'Ø'
+    0x00,0x00,0x00,0x1F,0x23,0x43,0x45,0x49,0x51,0x61,0x62,0xBC,0x00,0x00,0x00,0x00,
+    // U+00D9 'Ù'
+    0x10,0x08,0x00,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x3E,0x00,0x00,0x00,0x00,
+    // U+00DA 'Ú'
+    0x04,0x08,0x00,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x3E,0x00,0x00,0x00,0x00,
+    // U+00DB 'Û'
+    0x08,0x14,0x00,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x3E,0x00,0x00,0x00,0x00,
+    // U+00DC 'Ü'
+    0x00,0x14,0x00,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x3E,0x00,0x00,0x00,0x00,
+    // U+00DD 'Ý'
+    0x08,0x10,0x00,0x82,0x44,0x28,0x28,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // U+00DE 'Þ'
+    0x00,0x00,0x00,0x40,0x7E,0x43,0x41,0x43,0x7E,0x40,0x40,0x40,0x00,0x00,0x00,0x00,
+    // U+00DF 'ß'
+    0x00,0x38,0x44,0x44,0x48,0x50,0x50,0x5C,0x46,0x42,0x42,0x5C,0x00,0x00,0x00,0x00,
+    // U+00E0 'à'
+    0x00,0x00,0x10,0x08,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E1 'á'
+    0x00,0x00,0x08,0x10,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E2 'â'
+    0x00,0x00,0x18,0x24,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E3 'ã'
+    0x00,0x00,0x34,0x2C,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E4 'ä'
+    0x00,0x00,0x28,0x00,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E5 'å'
+    0x18,0x24,0x24,0x18,0x00,0x1C,0x22,0x02,0x3E,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00E6 'æ'
+    0x00,0x00,0x00,0x00,0x00,0x6C,0x12,0x12,0x7E,0x50,0x50,0x6E,0x00,0x00,0x00,0x00,
+    // U+00E7 'ç'
+    0x00,0x00,0x00,0x00,0x00,0x1C,0x22,0x40,0x40,0x40,0x22,0x1C,0x04,0x04,0x1C,0x00,
+    // U+00E8 'è'
+    0x00,0x00,0x10,0x08,0x00,0x3C,0x66,0x42,0x7E,0x40,0x62,0x3C,0x00,0x00,0x00,0x00,
+    // U+00E9 'é'
+    0x00,0x00,0x08,0x10,0x00,0x3C,0x66,0x42,0x7E,0x40,0x62,0x3C,0x00,0x00,0x00,0x00,
+    // U+00EA 'ê'
+    0x00,0x00,0x18,0x24,0x00,0x3C,0x66,0x42,0x7E,0x40,0x62,0x3C,0x00,0x00,0x00,0x00,
+    // U+00EB 'ë'
+    0x00,0x00,0x48,0x00,0x00,0x3C,0x66,0x42,0x7E,0x40,0x62,0x3C,0x00,0x00,0x00,0x00,
+    // U+00EC 'ì'
+    0x00,0x00,0x10,0x08,0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00ED 'í'
+    0x00,0x00,0x08,0x10,0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00EE 'î'
+    0x00,0x00,0x30,0x48,0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00EF 'ï'
+    0x00,0x00,0x28,0x00,0x00,0x70,0x10,0x10,0x10,0x10,0x10,0x7C,0x00,0x00,0x00,0x00,
+    // U+00F0 'ð'
+    0x00,0x30,0x1C,0x38,0x04,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F1 'ñ'
+    0x00,0x00,0x34,0x2C,0x00,0x5C,0x62,0x42,0x42,0x42,0x42,0x42,0x00,0x00,0x00,0x00,
+    // U+00F2 'ò'
+    0x00,0x00,0x10,0x08,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F3 'ó'
+    0x00,0x00,0x08,0x10,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F4 'ô'
+    0x00,0x00,0x18,0x24,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F5 'õ'
+    0x00,0x00,0x34,0x2C,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F6 'ö'
+    0x00,0x00,0x24,0x00,0x00,0x3C,0x66,0x42,0x42,0x42,0x66,0x3C,0x00,0x00,0x00,0x00,
+    // U+00F7 '÷'
+    0x00,0x00,0x00,0x00,0x18,0x18,0x00,0xFF,0x00,0x18,0x18,0x00,0x00,0x00,0x00,0x00,
+    // U+00F8 'ø'
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x66,0x4E,0x5A,0x72,0x66,0x7C,0x00,0x00,0x00,0x00,
+    // U+00F9 'ù'
+    0x00,0x00,0x10,0x08,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00FA 'ú'
+    0x00,0x00,0x08,0x10,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00FB 'û'
+    0x00,0x00,0x18,0x24,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00FC 'ü'
+    0x00,0x00,0x24,0x00,0x00,0x42,0x42,0x42,0x42,0x42,0x46,0x3A,0x00,0x00,0x00,0x00,
+    // U+00FD 'ý'
+    0x00,0x00,0x08,0x10,0x00,0x42,0x22,0x24,0x24,0x14,0x18,0x08,0x08,0x10,0x30,0x00,
+    // U+00FE 'þ'
+    0x00,0x40,0x40,0x40,0x40,0x7C,0x66,0x42,0x42,0x42,0x66,0x7C,0x40,0x40,0x40,0x00,
+    // U+00FF 'ÿ'
+    0x00,0x00,0x28,0x00,0x00,0x42,0x22,0x24,0x24,0x14,0x18,0x08,0x08,0x10,0x30,0x00,
+    // U+03C0 'π'
+    0x00,0x00,0x00,0x00,0x7E,0x64,0x64,0x64,0x64,0x64,0x67,0x00,0x00,0x00,0x00,0x00,
+    // U+2010 '‐'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2011 '‑'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x38,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2012 '‒'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2013 '–'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2014 '—'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2015 '―'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2016 '‖'
+    0x00,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x44,0x00,0x00,
+    // U+2017 '‗'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0xFF,0x00,
+    // U+2018 '‘'
+    0x00,0x04,0x08,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2019 '’'
+    0x00,0x0C,0x0C,0x08,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+201A '‚'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x10,0x20,0x00,0x00,
+    // U+201B '‛'
+    0x00,0x00,0x18,0x18,0x18,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+201C '“'
+    0x00,0x12,0x24,0x6C,0x6C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+201D '”'
+    0x00,0x36,0x36,0x24,0x48,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+201E '„'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x36,0x36,0x24,0x48,0x00,0x00,
+    // U+201F '‟'
+    0x00,0x00,0x6C,0x6C,0x24,0x24,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2020 '†'
+    0x00,0x00,0x00,0x10,0x10,0x10,0x7C,0x10,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,
+    // U+2021 '‡'
+    0x00,0x00,0x00,0x10,0x10,0x10,0x7C,0x10,0x10,0x7C,0x10,0x10,0x10,0x00,0x00,0x00,
+    // U+2022 '•'
+    0x00,0x00,0x00,0x00,0x00,0x18,0x3C,0x3C,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2023 '‣'
+    0x00,0x00,0x00,0x00,0x00,0x20,0x38,0x3C,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2024 '․'
+    0x00,0x00,0x00,0x7F,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x7F,0x00,0x00,
+    // U+2025 '‥'
+    0x00,0x00,0x00,0x7F,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x7F,0x00,0x00,
+    // U+2026 '…'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6D,0x6D,0x00,0x00,0x00,0x00,
+    // U+2027 '‧'
+    0x00,0x00,0x00,0x7F,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x41,0x7F,0x00,0x00,
+    // U+2190 '←'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x40,0xFE,0x40,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2191 '↑'
+    0x00,0x00,0x00,0x00,0x00,0x18,0x34,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00,0x00,
+    // U+2192 '→'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x02,0xFE,0x06,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2193 '↓'
+    0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x10,0x10,0x10,0x34,0x18,0x00,0x00,0x00,0x00,
+    // U+2194 '↔'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x42,0xFE,0x46,0x00,0x00,0x00,0x00,0x00,0x00,
+    // U+2195 '↕'
+    0x00,0x00,0x00,0x00,0x00,0x18,0x34,0x10,0x10,0x10,0x34,0x18,0x00,0x00,0x00,0x00,
+    // U+2196 '↖'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x70,0x70,0x58,0x0C,0x04,0x00,0x00,0x00,0x00,
+    // U+2197 '↗'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0E,0x0A,0x12,0x20,0x40,0x00,0x00,0x00,0x00,
+    // U+2198 '↘'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x30,0x1A,0x0E,0x0E,0x00,0x00,0x00,0x00,
+    // U+2199 '↙'
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x08,0x50,0x60,0x70,0x00,0x00,0x00,0x00,
+    // U+2260 '≠'
+    0x00,0x00,0x00,0x00,0x03,0x02,0x7F,0x08,0x18,0x7F,0x20,0x40,0x00,0x00,0x00,0x00,
+    // U+2264 '≤'
+    0x00,0x00,0x00,0x00,0x00,0x03,0x1E,0x60,0x1C,0x03,0x00,0x7F,0x00,0x00,0x00,0x00,
+    // U+2265 '≥'
+    0x00,0x00,0x00,0x00,0x00,0x60,0x3C,0x03,0x1C,0x60,0x00,0x7F,0x00,0x00,0x00,0x00,
+    // U+25C6 '◆'
+    0x00,0x00,0x00,0x00,0x18,0x3C,0x7E,0xFF,0x7E,0x3C,0x18,0x00,0x00,0x00,0x00,0x00,
+};
+
+// Page of each codepoint high byte
+static const uint8_t pageIndex[256] PROGMEM = {
+    0x00,0xFF,0xFF,0x01,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0x02,0x03,0x04,0xFF,0xFF,0x05,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+};
+
+// Glyph index of each codepoint low byte, per page
+static const uint16_t pages[PAGE_COUNT][256] PROGMEM = {
+    {  // U+00xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0x0000,0x0001,0x0002,0x0003,0x0004,0x0005,0x0006,0x0007,0x0008,0x0009,0x000A,0x000B,0x000C,0x000D,0x000E,0x000F,
+        0x0010,0x0011,0x0012,0x0013,0x0014,0x0015,0x0016,0x0017,0x0018,0x0019,0x001A,0x001B,0x001C,0x001D,0x001E,0x001F,
+        0x0020,0x0021,0x0022,0x0023,0x0024,0x0025,0x0026,0x0027,0x0028,0x0029,0x002A,0x002B,0x002C,0x002D,0x002E,0x002F,
+        0x0030,0x0031,0x0032,0x0033,0x0034,0x0035,0x0036,0x0037,0x0038,0x0039,0x003A,0x003B,0x003C,0x003D,0x003E,0x003F,
+        0x0040,0x0041,0x0042,0x0043,0x0044,0x0045,0x0046,0x0047,0x0048,0x0049,0x004A,0x004B,0x004C,0x004D,0x004E,0x004F,
+        0x0050,0x0051,0x0052,0x0053,0x0054,0x0055,0x0056,0x0057,0x0058,0x0059,0x005A,0x005B,0x005C,0x005D,0x005E,0x005F,
+    },
+    {  // U+03xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0x0060,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+    },
+    {  // U+20xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0x0061,0x0062,0x0063,0x0064,0x0065,0x0066,0x0067,0x0068,0x0069,0x006A,0x006B,0x006C,0x006D,0x006E,0x006F,0x0070,
+        0x0071,0x0072,0x0073,0x0074,0x0075,0x0076,0x0077,0x0078,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+    },
+    {  // U+21xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0x0079,0x007A,0x007B,0x007C,0x007D,0x007E,0x007F,0x0080,0x0081,0x0082,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+    },
+    {  // U+22xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0x0083,0xFFFF,0xFFFF,0xFFFF,0x0084,0x0085,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+    },
+    {  // U+25xx
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0x0086,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+        0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,0xFFFF,
+    },
+};
+
+/**
+ * Look up a Unicode codepoint in the extended font tables.
+ * Returns pointer to PROGMEM glyph data, or nullptr if not found.
+ */
+inline const uint8_t* lookup(uint16_t cp) {
+    uint8_t page = pgm_read_byte(&pageIndex[cp >> 8]);
+    if (page == NO_PAGE) return nullptr;
+    uint16_t glyph = pgm_read_word(&pages[page][cp & 0xFF]);
+    if (glyph == NO_GLYPH) return nullptr;
+    return &glyphs[glyph * BYTES_PER_GLYPH];
+}
+
+} // namespace TermFontExt8x16
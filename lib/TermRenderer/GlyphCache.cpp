@@ -0,0 +1,66 @@
+#include "GlyphCache.h"
+
+void GlyphCache::clear() {
+  for (int b = 0; b < BUCKETS; b++) _buckets[b] = NONE;
+  for (int i = 0; i < ENTRIES; i++) {
+    _entries[i].shade = FREE;
+    _entries[i].chain = NONE;
+    _entries[i].prev = i > 0 ? i - 1 : NONE;
+    _entries[i].next = i + 1 < ENTRIES ? i + 1 : NONE;
+  }
+  _head = 0;
+  _tail = ENTRIES - 1;
+  _hits = _misses = 0;
+}
+
+void GlyphCache::unlink(uint8_t i) {
+  Entry& e = _entries[i];
+  if (e.prev != NONE) _entries[e.prev].next = e.next; else _head = e.next;
+  if (e.next != NONE) _entries[e.next].prev = e.prev; else _tail = e.prev;
+}
+
+void GlyphCache::pushFront(uint8_t i) {
+  Entry& e = _entries[i];
+  e.prev = NONE;
+  e.next = _head;
+  if (_head != NONE) _entries[_head].prev = i; else _tail = i;
+  _head = i;
+}
+
+// Remove an entry from its hash bucket's chain
+void GlyphCache::unchain(uint8_t i) {
+  uint8_t* link = &_buckets[_entries[i].bucket];
+  while (*link != i) link = &_entries[*link].chain;
+  *link = _entries[i].chain;
+}
+
+uint32_t* GlyphCache::lookup(uint16_t codepoint, uint16_t shade, bool& hit) {
+  uint8_t b = hash(codepoint, shade);
+  for (uint8_t i = _buckets[b]; i != NONE; i = _entries[i].chain) {
+    Entry& e = _entries[i];
+    if (e.codepoint == codepoint && e.shade == shade) {
+      if (i != _head) {
+        unlink(i);
+        pushFront(i);
+      }
+      _hits++;
+      hit = true;
+      return e.raster;
+    }
+  }
+
+  // Miss: recycle the least recently used entry
+  uint8_t i = _tail;
+  Entry& e = _entries[i];
+  if (e.shade != FREE) unchain(i);
+  unlink(i);
+  pushFront(i);
+  e.codepoint = codepoint;
+  e.shade = shade;
+  e.bucket = b;
+  e.chain = _buckets[b];
+  _buckets[b] = i;
+  _misses++;
+  hit = false;
+  return e.raster;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include "TermFont.h"
+#include "term_config.h"
+
+// LRU cache of composed cell rasters: a character drawn on one background
+// level with its ink inverted or not and its attributes (bold, underline,
+// ...) applied, in the framebuffer's bit layout
+// (one MSB-first word per framebuffer row of the cell, not yet shifted to
+// the cell's x). A hit skips glyph resolution, the font read and the
+// dither entirely.
+class GlyphCache {
+ public:
+  static constexpr int ENTRIES = GLYPH_CACHE_ENTRIES;
+  static constexpr int WORDS = TermFont::MAX_HEIGHT > TermFont::MAX_WIDTH
+                                   ? TermFont::MAX_HEIGHT : TermFont::MAX_WIDTH;
+
+  GlyphCache() { clear(); }
+
+  // Raster for (codepoint, shade); shade packs the background level, the
+  // inversion and the attributes. On a miss (hit = false) the least
+  // recently used entry is handed out for the caller to fill.
+  uint32_t* lookup(uint16_t codepoint, uint16_t shade, bool& hit);
+
+  // Drop every entry (font or orientation changed)
+  void clear();
+
+  uint32_t hits() const { return _hits; }
+  uint32_t misses() const { return _misses; }
+  // Percent of lookups served from the cache since the last clear()
+  int hitRate() const {
+    uint32_t total = _hits + _misses;
+    return total ? (uint64_t)_hits * 100 / total : 0;
+  }
+
+ private:
+  static constexpr int BUCKETS = 128;  // power of two
+  static constexpr uint8_t NONE = 0xFF;
+  static constexpr uint16_t FREE = 0xFFFF;  // shade of an unused entry
+  static_assert(ENTRIES < NONE, "entry index must fit a byte");
+
+  struct Entry {
+    uint16_t codepoint;
+    uint16_t shade;        // FREE = unused
+    uint8_t bucket;
+    uint8_t chain;         // next entry in the bucket
+    uint8_t prev, next;    // LRU list, most recent first
+    uint32_t raster[WORDS];
+  };
+  Entry _entries[ENTRIES];
+  uint8_t _buckets[BUCKETS];
+  uint8_t _head, _tail;
+  uint32_t _hits = 0, _misses = 0;
+
+  static uint8_t hash(uint16_t codepoint, uint16_t shade) {
+    uint32_t h = codepoint * 0x9E3779B1u ^ shade * 0x85EBCA6Bu;
+    return (h >> 16) & (BUCKETS - 1);
+  }
+  void unlink(uint8_t i);
+  void pushFront(uint8_t i);
+  void unchain(uint8_t i);
+};
@@ -1,166 +1,646 @@
 #include "TermRenderer.h"
 #include "TermCell.h"
-#include "term_font_10x20.h"
+#include <cstring>
 
 // 4x4 Bayer dithering matrix (threshold values 0-15)
-static const uint8_t kBayer4x4[4][4] = {
+static constexpr uint8_t kBayer4x4[4][4] = {
     { 0,  8,  2, 10},
     {12,  4, 14,  6},
     { 3, 11,  1,  9},
     {15,  7, 13,  5}
 };
 
-void TermRenderer::blitGlyph(int px, int py, const uint8_t* glyph,
-                              uint8_t bgBright, bool invertGlyph) {
-  uint8_t* fb = _display.getFrameBuffer();
-  constexpr int fbStride = DISPLAY_W / 8;  // 100 bytes per row
-
-  for (int gy = 0; gy < TERM_FONT_H; gy++) {
-    int fbY = py + gy;
-    if (fbY >= DISPLAY_H) break;
-
-    for (int gx = 0; gx < TERM_FONT_W; gx++) {
-      int fbX = px + gx;
-      if (fbX >= DISPLAY_W) break;
-
-      // Read glyph bit (MSB-first)
-      int glyphByteIdx = gy * TermFont::BYTES_PER_ROW + (gx / 8);
-      int glyphBitIdx = 7 - (gx % 8);
-      bool isGlyphPixel = (pgm_read_byte(&glyph[glyphByteIdx]) >> glyphBitIdx) & 1;
-
-      bool drawBlack;
-      if (isGlyphPixel) {
-        // Foreground: black normally, white on dark backgrounds
-        drawBlack = !invertGlyph;
-      } else {
-        // Background: Bayer-dithered based on brightness
-        // bgBright=255 → all white, bgBright=0 → all black
-        int threshold = kBayer4x4[gy & 3][gx & 3];  // 0-15
-        int level = (bgBright * 17) >> 8;            // 0-16
-        drawBlack = (level <= threshold);
+// Background dither per brightness level (0-16) and glyph row (y & 3) as
+// an MSB-first row of 32 pixels, bit set = black: a pixel is black where
+// level <= threshold
+struct BayerRows {
+  uint32_t mask[17][4];
+};
+
+static constexpr BayerRows buildBayerRows() {
+  BayerRows t{};
+  for (int level = 0; level <= 16; level++) {
+    for (int y = 0; y < 4; y++) {
+      for (int x = 0; x < 32; x++) {
+        if (level <= kBayer4x4[y][x & 3]) t.mask[level][y] |= 0x80000000u >> x;
       }
+    }
+  }
+  return t;
+}
+
+static constexpr BayerRows kBayerRows = buildBayerRows();
+
+// Transpose an 8x8 bit matrix, one row per byte, first row in the top
+// byte (Hacker's Delight 7-3)
+static inline uint64_t transpose8(uint64_t x) {
+  x = (x & 0xAA55AA55AA55AA55ull) | ((x & 0x00AA00AA00AA00AAull) << 7) |
+      ((x >> 7) & 0x00AA00AA00AA00AAull);
+  x = (x & 0xCCCC3333CCCC3333ull) | ((x & 0x0000CCCC0000CCCCull) << 14) |
+      ((x >> 14) & 0x0000CCCC0000CCCCull);
+  x = (x & 0xF0F0F0F00F0F0F0Full) | ((x & 0x00000000F0F0F0F0ull) << 28) |
+      ((x >> 28) & 0x00000000F0F0F0F0ull);
+  return x;
+}
+
+// Merge an MSB-first run of pixels into a framebuffer row starting at
+// bit `shift` of p[0]: one read-modify-write per byte the run touches.
+// The run plus shift must fit in 32 bits (cells up to 24 pixels).
+// Returns the number of pixels that changed.
+static inline int storeBits(uint8_t* p, int shift, uint32_t bits, uint32_t mask) {
+  bits >>= shift;
+  mask >>= shift;
+  uint32_t changed = 0;
+  for (; mask; p++, bits <<= 8, mask <<= 8) {
+    uint8_t m = mask >> 24;
+    uint8_t v = (*p & ~m) | ((bits >> 24) & m);
+    changed = changed << 8 | (uint8_t)(*p ^ v);
+    *p = v;
+  }
+  return __builtin_popcount(changed);
+}
+
+static constexpr int kFbStride = DISPLAY_W / 8;  // 100 bytes per row
+
+// Pixels that differ between two framebuffer byte runs
+static int countChanged(const uint8_t* a, const uint8_t* b, int n) {
+  int count = 0;
+  for (; n >= 4; n -= 4, a += 4, b += 4) {
+    uint32_t x, y;
+    memcpy(&x, a, 4);
+    memcpy(&y, b, 4);
+    count += __builtin_popcount(x ^ y);
+  }
+  for (; n > 0; n--) count += __builtin_popcount(*a++ ^ *b++);
+  return count;
+}
+
+// Copy pixels [x0, x1) of framebuffer rows [y0, y1) dy rows down (up if
+// negative), within those rows. Rows moved away from keep their pixels.
+// The pixels changed are added to the ghosting count of each row's band.
+static void moveFbRows(uint8_t* fb, uint32_t* ghost, int y0, int y1, int dy, int x0, int x1) {
+  int n = y1 - y0 - (dy < 0 ? -dy : dy);
+  if (n <= 0) return;
+  int from = dy < 0 ? y0 - dy : y0;
+  if (x0 == 0 && x1 == DISPLAY_W) {
+    for (int y = from; y < from + n; y++) {
+      ghost[(y + dy) / GHOST_BAND_ROWS] +=
+          countChanged(&fb[y * kFbStride], &fb[(y + dy) * kFbStride], kFbStride);
+    }
+    memmove(&fb[(from + dy) * kFbStride], &fb[from * kFbStride], n * kFbStride);
+    return;
+  }
+  int b0 = x0 >> 3, b1 = (x1 - 1) >> 3;
+  uint8_t m0 = 0xFF >> (x0 & 7), m1 = 0xFF << (7 - ((x1 - 1) & 7));
+  if (b0 == b1) m0 = m1 = m0 & m1;
+  for (int i = 0; i < n; i++) {
+    int y = dy > 0 ? from + n - 1 - i : from + i;  // don't overrun the source
+    const uint8_t* src = &fb[y * kFbStride];
+    uint8_t* dst = &fb[(y + dy) * kFbStride];
+    int changed = __builtin_popcount((src[b0] ^ dst[b0]) & m0);
+    dst[b0] = (dst[b0] & ~m0) | (src[b0] & m0);
+    if (b1 > b0 + 1) {
+      changed += countChanged(&src[b0 + 1], &dst[b0 + 1], b1 - b0 - 1);
+      memcpy(&dst[b0 + 1], &src[b0 + 1], b1 - b0 - 1);
+    }
+    if (b1 > b0) changed += __builtin_popcount((src[b1] ^ dst[b1]) & m1);
+    dst[b1] = (dst[b1] & ~m1) | (src[b1] & m1);
+    ghost[(y + dy) / GHOST_BAND_ROWS] += changed;
+  }
+}
+
+// Shift pixels [x0, x1) of framebuffer rows [y0, y1) dx pixels right (left
+// if negative), within that span. Pixels moved away from keep their value.
+static void shiftFbCols(uint8_t* fb, uint32_t* ghost, int y0, int y1, int x0, int x1, int dx) {
+  int d0 = dx > 0 ? x0 + dx : x0, d1 = dx > 0 ? x1 : x1 + dx;
+  if (d0 >= d1) return;
+  uint8_t src[kFbStride + 1];
+  src[kFbStride] = 0xFF;
+  for (int y = y0; y < y1; y++) {
+    uint8_t* row = &fb[y * kFbStride];
+    memcpy(src, row, kFbStride);
+    for (int x = d0; x < d1; x += 8) {
+      int s = x - dx;
+      uint8_t bits = ((src[s >> 3] << 8) | src[(s >> 3) + 1]) >> (8 - (s & 7));
+      int n = d1 - x < 8 ? d1 - x : 8;
+      ghost[y / GHOST_BAND_ROWS] += storeBits(&row[x >> 3], x & 7, (uint32_t)bits << 24,
+                                              ~0u << (32 - n));
+    }
+  }
+}
+
+// Background brightness a cell is drawn with (inverse applied)
+static uint8_t effectiveBg(const TermStyle& style) {
+  bool isInverse = (style.attrs & TermStyle::ATTR_INVERSE) != 0;
+  return isInverse ? 255 - style.bg : style.bg;
+}
+
+void TermRenderer::setLayout(uint8_t font, bool portrait) {
+  if (font >= TermFont::FONT_COUNT) font = TermFont::FONT_10X20;
+  _fontId = font;
+  _font = &TermFont::face(_fontId);
+  _portrait = portrait;
+  _width = portrait ? DISPLAY_H : DISPLAY_W;
+  _height = portrait ? DISPLAY_W : DISPLAY_H;
+  _cols = (_width - TERM_MARGIN_X * 2) / _font->width;
+  _rows = _height / _font->height;
+  if (_cols > TERM_MAX_COLS) _cols = TERM_MAX_COLS;
+  if (_rows > TERM_MAX_ROWS) _rows = TERM_MAX_ROWS;
+  if (_cols * _rows > TERM_MAX_CELLS) _rows = TERM_MAX_CELLS / _cols;
+  _offsetX = (_width - _cols * _font->width) / 2;
+  _offsetY = (_height - _rows * _font->height) / 2;
 
-      // Write to framebuffer (bit=1 → white, bit=0 → black)
-      int fbByteIdx = fbY * fbStride + (fbX / 8);
-      int fbBitIdx = 7 - (fbX % 8);
-      if (drawBlack) {
-        fb[fbByteIdx] &= ~(1 << fbBitIdx);
-      } else {
-        fb[fbByteIdx] |= (1 << fbBitIdx);
+  // Underline goes just below the baseline, strikethrough through the
+  // middle of the x-height
+  uint32_t x[TermFont::MAX_HEIGHT];
+  _font->render('x', x);
+  int top = 0, bottom = _font->height - 1;
+  while (top < bottom && !x[top]) top++;
+  while (bottom > top && !x[bottom]) bottom--;
+  _baseline = bottom;
+  _strikeRow = (top + bottom) / 2;
+
+  _cursorShown = false;
+  _glyphCache.clear();
+}
+
+// Derive an attribute variant from a glyph's ink, once per cache entry:
+// italic slants the rows about the baseline (not drawn glyphs, which must
+// meet their neighbours), bold smears the ink a pixel right, underline and
+// strikethrough lay a row across the cell and dim keeps every other ink
+// pixel, a checkerboard dither of the foreground.
+void TermRenderer::styleGlyph(uint32_t* ink, uint8_t attrs, bool drawn) const {
+  const int fontH = _font->height;
+  const uint32_t cellMask = ~0u << (32 - _font->width);
+  const int underline = _baseline + 1 < fontH ? _baseline + 1 : _baseline;
+  for (int gy = 0; gy < fontH; gy++) {
+    uint32_t row = ink[gy];
+    if ((attrs & TermStyle::ATTR_ITALIC) && !drawn) {
+      int shift = (_baseline - gy) / 5;
+      row = shift >= 0 ? row >> shift : row << -shift;
+    }
+    if (attrs & TermStyle::ATTR_BOLD) row |= row >> 1;
+    if ((attrs & TermStyle::ATTR_UNDERLINE) && gy == underline) row = ~0u;
+    if ((attrs & TermStyle::ATTR_STRIKE) && gy == _strikeRow) row = ~0u;
+    if (attrs & TermStyle::ATTR_DIM) row &= (gy & 1) ? 0x55555555u : 0xAAAAAAAAu;
+    if (attrs & TermStyle::ATTR_HIDDEN) row = 0;
+    ink[gy] = row & cellMask;
+  }
+}
+
+// Compose a cell raster in framebuffer layout from the glyph's ink rows.
+// Each row is built in a 32-bit word: ink bits select foreground or the
+// background dither row. Portrait turns the cell: a logical column becomes a framebuffer
+// row, with the last glyph row leftmost.
+void TermRenderer::composeGlyph(const uint32_t* ink, int level, bool invertGlyph,
+                                uint32_t* out) const {
+  const int fontW = _font->width, fontH = _font->height;
+  const uint32_t cellMask = ~0u << (32 - fontW);
+
+  // Foreground: black normally, white on dark backgrounds.
+  // Background: Bayer-dithered, level 16 → all white, 0 → all black.
+  const uint32_t fgBlack = invertGlyph ? 0 : cellMask;
+  const uint32_t* bgBlack = kBayerRows.mask[level];
+
+  // Framebuffer bits: 1 = white, 0 = black
+  uint32_t rows[TermFont::MAX_HEIGHT];
+  uint32_t* dst = _portrait ? rows : out;
+  for (int gy = 0; gy < fontH; gy++) {
+    uint32_t black = (ink[gy] & fgBlack) | (~ink[gy] & bgBlack[gy & 3]);
+    dst[gy] = ~black & cellMask;
+  }
+  if (!_portrait) return;
+
+  // Turn the cell in 8x8 blocks, bottom row first
+  for (int gx = 0; gx < fontW; gx++) out[gx] = 0;
+  for (int by = 0; by < fontH; by += 8) {
+    for (int bx = 0; bx < fontW; bx += 8) {
+      uint64_t block = 0;
+      for (int i = 0; i < 8; i++) {
+        int gy = fontH - 1 - (by + i);
+        block = (block << 8) | (gy >= 0 ? (uint8_t)(rows[gy] >> (24 - bx)) : 0);
+      }
+      block = transpose8(block);
+      for (int j = 0; j < 8 && bx + j < fontW; j++) {
+        out[bx + j] |= (uint32_t)(uint8_t)(block >> (56 - 8 * j)) << (24 - by);
       }
     }
   }
 }
 
-void TermRenderer::renderRow(int row) {
-  for (int col = 0; col < TERM_COLS; col++) {
-    const TermCell& cell = _buf.cellAt(row, col);
-    const uint8_t* glyph = TermFont::getGlyph(cell.codepoint);
+// Draw a cell from its cached raster. Only a miss resolves the
+// codepoint to a glyph, applies the attributes and composes it.
+void TermRenderer::blitGlyph(int px, int py, uint16_t codepoint,
+                              uint8_t bgBright, bool invertGlyph, uint8_t attrs) {
+  int level = (bgBright * 17) >> 8;  // 0-16
+  bool hit;
+  uint32_t* raster = _glyphCache.lookup(codepoint, level | invertGlyph << 5 | attrs << 6, hit);
+  if (!hit) {
+    uint32_t ink[TermFont::MAX_HEIGHT];
+    bool drawn = _font->render(codepoint, ink);
+    if (attrs) styleGlyph(ink, attrs, drawn);
+    composeGlyph(ink, level, invertGlyph, raster);
+  }
+
+  uint8_t* fb = back();
+  const int fontW = _font->width, fontH = _font->height;
 
-    // Determine effective background brightness
-    uint8_t bgBright = cell.bgBright;
-    bool isInverse = (cell.attrs & TermCell::ATTR_INVERSE) != 0;
-    if (isInverse) bgBright = 255 - bgBright;
+  // Portrait: logical x runs down the panel, y from right to left
+  int fbX = _portrait ? DISPLAY_W - py - fontH : px;
+  int fbY = _portrait ? px : py;
+  int words = _portrait ? fontW : fontH;
+  uint32_t mask = ~0u << (32 - (_portrait ? fontH : fontW));
+  uint8_t* p = &fb[fbY * kFbStride + (fbX >> 3)];
+  for (int i = 0; i < words; i++, p += kFbStride) {
+    _ghost[(fbY + i) / GHOST_BAND_ROWS] += storeBits(p, fbX & 7, raster[i], mask);
+  }
+}
+
+void TermRenderer::renderRow(int row, int minCol, int maxCol) {
+  for (int col = minCol; col <= maxCol; col++) {
+    const TermCell& cell = _buf->cellAt(row, col);
+    const TermStyle& style = _buf->style(cell.style);
+    uint8_t bgBright = effectiveBg(style);
 
     // Invert glyph when background is dark (for readability)
     bool invertGlyph = bgBright < 128;
 
-    blitGlyph(TERM_OFFSET_X + col * TERM_FONT_W, row * TERM_FONT_H,
-              glyph, bgBright, invertGlyph);
+    blitGlyph(_offsetX + col * _font->width, _offsetY + row * _font->height,
+              cell.codepoint, bgBright, invertGlyph, style.attrs & GLYPH_ATTRS);
   }
 }
 
-void TermRenderer::renderDirty() {
-  uint32_t dirty = _buf.dirtyRows();
+// Narrow a dirty span to the cells that differ from the shadow and record
+// them as drawn. Returns false if the whole span is unchanged.
+bool TermRenderer::diffRow(int row, uint8_t& minCol, uint8_t& maxCol) {
+  ShadowCell* shadow = &_shadow[row * _buf->cols()];
+  int first = -1, last = -1;
+  for (int col = minCol; col <= maxCol; col++) {
+    const TermCell& cell = _buf->cellAt(row, col);
+    const TermStyle& style = _buf->style(cell.style);
+    ShadowCell drawn = {cell.codepoint, effectiveBg(style), (uint8_t)(style.attrs & GLYPH_ATTRS)};
+    const ShadowCell& s = shadow[col];
+    if (s.codepoint == drawn.codepoint && s.bg == drawn.bg && s.attrs == drawn.attrs) continue;
+    shadow[col] = drawn;
+    if (first < 0) first = col;
+    last = col;
+  }
+  if (first < 0) return false;
+  minCol = first;
+  maxCol = last;
+  return true;
+}
 
-  // Always include the previous cursor row so the old cursor gets erased
-  if (_lastCursorRow >= 0) {
-    dirty |= (1u << _lastCursorRow);
+// A logical rectangle on the panel, widened to whole framebuffer bytes
+// (8 pixels) horizontally
+TermRenderer::Window TermRenderer::panelWindow(int x, int y, int w, int h) const {
+  if (_portrait) {
+    int px = DISPLAY_W - (y + h);
+    int py = x;
+    x = px;
+    y = py;
+    int t = w;
+    w = h;
+    h = t;
   }
+  return {x & ~7, y, (x + w + 7) & ~7, y + h};
+}
 
-  if (dirty == 0) return;
+// What refreshing a window costs: a fixed overhead plus its area
+long TermRenderer::windowCost(const Window& w) {
+  return REFRESH_WINDOW_COST + (long)(w.x1 - w.x0) * (w.y1 - w.y0);
+}
 
-  int dirtyCount = __builtin_popcount(dirty);
+TermRenderer::Window TermRenderer::unite(const Window& a, const Window& b) {
+  return {a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+          a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1};
+}
 
-  // Render all dirty rows into framebuffer (this erases old cursor too)
-  for (int row = 0; row < TERM_ROWS; row++) {
-    if (dirty & (1u << row)) {
-      renderRow(row);
+// Merge neighbouring windows (in row order, so they never overlap) while
+// one is no dearer than two, then on until few enough remain
+int TermRenderer::mergeWindows(Window* w, int n) {
+  while (n > 1) {
+    int best = 0;
+    long bestGain = 0;
+    for (int i = 0; i + 1 < n; i++) {
+      long gain = windowCost(w[i]) + windowCost(w[i + 1]) - windowCost(unite(w[i], w[i + 1]));
+      if (i == 0 || gain > bestGain) {
+        best = i;
+        bestGain = gain;
+      }
     }
+    if (bestGain < 0 && n <= REFRESH_MAX_WINDOWS) break;
+    w[best] = unite(w[best], w[best + 1]);
+    for (int i = best + 1; i + 1 < n; i++) w[i] = w[i + 1];
+    n--;
   }
+  return n;
+}
 
-  // Draw cursor at new position
-  renderCursor();
+// Refresh the drawn column span of each row: one window per row to start
+// with, merged by cost. Damage far apart (a status line and the cursor,
+// split panes) goes out as separate windows; if those cost as much as the
+// whole panel, the whole panel is refreshed instead.
+void TermRenderer::planWindows() {
+  const int fontW = _font->width, fontH = _font->height;
+  Window windows[TERM_MAX_ROWS];
+  int n = 0;
+  for (int row = _drawn.first(); row >= 0 && row <= _drawn.last(); row++) {
+    if (!_drawn.test(row)) continue;
+    windows[n++] = panelWindow(_offsetX + _drawnMin[row] * fontW, _offsetY + row * fontH,
+                               (_drawnMax[row] - _drawnMin[row] + 1) * fontW, fontH);
+  }
+  n = mergeWindows(windows, n);
 
-  if (dirtyCount > DIRTY_ROWS_PARTIAL_MAX) {
-    // Many rows changed: full-screen fast refresh
-    _display.displayBuffer(EInkDisplay::FAST_REFRESH);
-    _fastRefreshCount++;
-  } else {
-    // Few rows changed: windowed partial update
-    int minRow = __builtin_ctz(dirty);
-    int maxRow = 31 - __builtin_clz(dirty);
-
-    // Also include cursor row in the window
-    int curRow = _buf.cursorRow();
-    if (curRow < minRow) minRow = curRow;
-    if (curRow > maxRow) maxRow = curRow;
-    // Include previous cursor position too
-    if (_lastCursorRow >= 0) {
-      if (_lastCursorRow < minRow) minRow = _lastCursorRow;
-      if (_lastCursorRow > maxRow) maxRow = _lastCursorRow;
+  long cost = 0;
+  for (int i = 0; i < n; i++) cost += windowCost(windows[i]);
+  if (cost >= windowCost({0, 0, DISPLAY_W, DISPLAY_H})) {
+    _refresh = REFRESH_FAST;
+    return;
+  }
+  _refresh = REFRESH_WINDOWS;
+  _windowCount = n;
+  for (int i = 0; i < n; i++) _windows[i] = windows[i];
+}
+
+// Move a logical pixel rectangle by (dx, dy), one of them zero, in the
+// framebuffer. Portrait swaps the two: logical x is the framebuffer row,
+// logical y runs right to left.
+void TermRenderer::moveRect(int x, int y, int w, int h, int dx, int dy) {
+  uint8_t* fb = back();
+  if (!_portrait) {
+    if (dy) moveFbRows(fb, _ghost, y, y + h, dy, x, x + w);
+    else shiftFbCols(fb, _ghost, y, y + h, x, x + w, dx);
+    return;
+  }
+  int fx = DISPLAY_W - (y + h);
+  if (dy) shiftFbCols(fb, _ghost, x, x + w, fx, fx + h, -dy);
+  else moveFbRows(fb, _ghost, x, x + w, dx, fx, fx + h);
+}
+
+// Add a column span to a row in a local dirty set
+static void addSpan(RowSet& dirty, uint8_t* minCol, uint8_t* maxCol,
+                    int row, int c0, int c1) {
+  if (!dirty.test(row)) {
+    dirty.set(row);
+    minCol[row] = c0;
+    maxCol[row] = c1;
+    return;
+  }
+  if (c0 < minCol[row]) minCol[row] = c0;
+  if (c1 > maxCol[row]) maxCol[row] = c1;
+}
+
+// Replay the buffer's moves on the framebuffer and the shadow, so the
+// diff below finds only what they exposed. The moved spans are collected
+// for the refresh. The cursor is taken off first, or it would move too.
+void TermRenderer::applyMoves(RowSet& moved, uint8_t* minCol, uint8_t* maxCol) {
+  const int cols = _buf->cols();
+  const int fontW = _font->width, fontH = _font->height;
+  if (_cursorShown) {
+    int col = _lastCursorCol < cols ? _lastCursorCol : cols - 1;
+    const ShadowCell& s = _shadow[_lastCursorRow * cols + col];
+    blitGlyph(_offsetX + col * fontW, _offsetY + _lastCursorRow * fontH,
+              s.codepoint, s.bg, s.bg < 128, s.attrs);
+    addSpan(moved, minCol, maxCol, _lastCursorRow, col, col);
+    _cursorShown = false;
+  }
+
+  for (int i = 0; i < _buf->moveCount(); i++) {
+    const TermBuffer::Move& m = _buf->move(i);
+    if (m.cells) {
+      int n = m.delta < 0 ? -m.delta : m.delta;
+      ShadowCell* row = &_shadow[m.top * cols];
+      int from = m.delta < 0 ? m.col + n : m.col;
+      memmove(&row[from + m.delta], &row[from], (cols - m.col - n) * sizeof(ShadowCell));
+      moveRect(_offsetX + m.col * fontW, _offsetY + m.top * fontH,
+               (cols - m.col) * fontW, fontH, m.delta * fontW, 0);
+      addSpan(moved, minCol, maxCol, m.top, m.col, cols - 1);
+    } else {
+      int n = m.delta < 0 ? -m.delta : m.delta;
+      int from = m.delta < 0 ? m.top + n : m.top;
+      memmove(&_shadow[(from + m.delta) * cols], &_shadow[from * cols],
+              (m.bottom - m.top + 1 - n) * cols * sizeof(ShadowCell));
+      // Whole panel rows: the margins are blank throughout
+      moveRect(0, _offsetY + m.top * fontH, _width, (m.bottom - m.top + 1) * fontH,
+               0, m.delta * fontH);
+      for (int r = m.top; r <= m.bottom; r++) addSpan(moved, minCol, maxCol, r, 0, cols - 1);
     }
+  }
+  _buf->clearMoves();
+}
+
+bool TermRenderer::cursorMoved() const {
+  return _cursorShown != _cursorVisible ||
+         (_cursorVisible && (_buf->cursorRow() != _lastCursorRow ||
+                             _buf->cursorCol() != _lastCursorCol));
+}
 
-    int y = minRow * TERM_FONT_H;
-    int h = (maxRow - minRow + 1) * TERM_FONT_H;
-    _display.displayWindow(0, y, DISPLAY_W, h);
-    _fastRefreshCount++;
+bool TermRenderer::echoOnly() const {
+  if (_buf->moveCount()) return false;
+  const RowSet& dirty = _buf->dirtyRows();
+  int cells = 0;
+  for (int row = dirty.first(); row >= 0 && row <= dirty.last(); row++) {
+    if (!dirty.test(row)) continue;
+    cells += _buf->dirtyMaxCol(row) - _buf->dirtyMinCol(row) + 1;
+    if (cells > ECHO_MAX_CELLS) return false;
   }
+  return cells || cursorMoved();
+}
+
+bool TermRenderer::drawDirty() {
+  RowSet dirty, moved;
+  const int rows = _buf->rows();
+  uint8_t minCol[TERM_MAX_ROWS], maxCol[TERM_MAX_ROWS];
+  uint8_t movedMin[TERM_MAX_ROWS], movedMax[TERM_MAX_ROWS];
+  if (_buf->moveCount()) applyMoves(moved, movedMin, movedMax);
+
+  for (int row = 0; row < rows; row++) {
+    if (!_buf->dirtyRows().test(row)) continue;
+    minCol[row] = _buf->dirtyMinCol(row);
+    maxCol[row] = _buf->dirtyMaxCol(row);
+    // Rewritten with what the panel already shows: nothing to draw
+    if (diffRow(row, minCol[row], maxCol[row])) dirty.set(row);
+  }
+  _buf->clearDirty();
+
+  // A moved or toggled cursor redraws its old and new cells
+  int curRow = _buf->cursorRow(), curCol = _buf->cursorCol();
+  bool cursorMoved = this->cursorMoved();
+  if (cursorMoved && _cursorShown) {
+    addSpan(dirty, minCol, maxCol, _lastCursorRow, _lastCursorCol, _lastCursorCol);
+  }
+
+  if (!dirty.any() && !cursorMoved && !moved.any()) return false;
 
-  // Periodic full refresh to clear ghosting
-  if (_fastRefreshCount >= FULL_REFRESH_INTERVAL) {
-    _display.displayBuffer(EInkDisplay::FULL_REFRESH);
-    _fastRefreshCount = 0;
+  // Render only the changed cells into framebuffer (this erases old cursor too)
+  for (int row = 0; row < rows; row++) {
+    if (dirty.test(row)) {
+      renderRow(row, minCol[row], maxCol[row]);
+    }
+  }
+
+  // Draw cursor at new position, and include its cell in the window
+  renderCursor();
+  if (cursorMoved && _cursorVisible) addSpan(dirty, minCol, maxCol, curRow, curCol, curCol);
+  _cursorShown = _cursorVisible;
+  _lastCursorRow = curRow;
+  _lastCursorCol = curCol;
+  for (int row = moved.first(); row >= 0 && row <= moved.last(); row++) {
+    if (moved.test(row)) addSpan(dirty, minCol, maxCol, row, movedMin[row], movedMax[row]);
   }
+  if (!dirty.any()) return false;
 
-  _lastCursorRow = _buf.cursorRow();
-  _lastCursorCol = _buf.cursorCol();
-  _buf.clearDirty();
+  for (int row = dirty.first(); row >= 0 && row <= dirty.last(); row++) {
+    if (dirty.test(row)) addSpan(_drawn, _drawnMin, _drawnMax, row, minCol[row], maxCol[row]);
+  }
+  return true;
 }
 
-void TermRenderer::renderFull() {
-  _buf.markAllDirty();
-  for (int row = 0; row < TERM_ROWS; row++) {
-    renderRow(row);
+void TermRenderer::drawFull(bool panelMatches) {
+  _buf->markAllDirty();
+  memset(back(), 0xFF, kFbStride * DISPLAY_H);  // margins, and anything left by another layout
+  for (int row = 0; row < _buf->rows(); row++) {
+    uint8_t minCol = 0, maxCol = _buf->cols() - 1;
+    diffRow(row, minCol, maxCol);
+    renderRow(row, 0, _buf->cols() - 1);
   }
   renderCursor();
-  _display.displayBuffer(EInkDisplay::FULL_REFRESH);
-  _fastRefreshCount = 0;
-  _lastCursorRow = _buf.cursorRow();
-  _lastCursorCol = _buf.cursorCol();
-  _buf.clearDirty();
+  // Drawing over the blank counted every inked pixel as a change; if the
+  // panel already shows this, nothing changed on it
+  if (panelMatches) memset(_ghost, 0, sizeof(_ghost));
+  uint8_t refresh = panelMatches ? REFRESH_FAST : REFRESH_FULL;
+  if (refresh > _drawnPanel) _drawnPanel = refresh;
+  _drawn.clear();
+  _cursorShown = _cursorVisible;
+  _lastCursorRow = _buf->cursorRow();
+  _lastCursorCol = _buf->cursorCol();
+  _buf->clearDirty();
+}
+
+// Decide which bands to clean: those over their ghosting budget, each run
+// of them inverted and restored by present(), two fast refreshes that
+// swing every pixel through both colours. At most GHOST_CLEAN_MAX_BANDS
+// per commit, the worst first; the rest wait for the next one. A cleaned
+// band's count starts over, and a full refresh resets them all. Whole
+// panel cleanup is left to cleanup() once the host is quiet.
+void TermRenderer::planCleaning() {
+  if (_refresh == REFRESH_FULL) {
+    memset(_ghost, 0, sizeof(_ghost));
+    return;
+  }
+  for (int n = 0; n < GHOST_CLEAN_MAX_BANDS; n++) {
+    int worst = -1;
+    for (int b = 0; b < GHOST_BANDS; b++) {
+      if (_ghost[b] >= GHOST_BAND_BUDGET && (worst < 0 || _ghost[b] > _ghost[worst])) worst = b;
+    }
+    if (worst < 0) break;
+    _cleanBands |= 1u << worst;
+    _ghost[worst] = 0;
+  }
+}
+
+bool TermRenderer::commit() {
+  _refresh = _drawnPanel;
+  _windowCount = 0;
+  _cleanBands = 0;
+  if (_refresh == REFRESH_NONE) {
+    if (!_drawn.any()) return false;
+    planWindows();
+  }
+  planCleaning();
+
+#if RENDER_BACK_BUFFER
+  uint8_t* fb = _display.getFrameBuffer();
+  if (_refresh == REFRESH_WINDOWS) {
+    for (int i = 0; i < _windowCount; i++) {
+      const Window& w = _windows[i];
+      for (int y = w.y0; y < w.y1; y++) {
+        int at = y * kFbStride + (w.x0 >> 3);
+        memcpy(&fb[at], &_back[at], (w.x1 - w.x0) >> 3);
+      }
+    }
+  } else {
+    memcpy(fb, _back, sizeof(_back));
+  }
+#endif
+  _drawn.clear();
+  _drawnPanel = REFRESH_NONE;
+  return true;
+}
+
+void TermRenderer::present() {
+  switch (_refresh) {
+    case REFRESH_WINDOWS:
+      for (int i = 0; i < _windowCount; i++) {
+        const Window& w = _windows[i];
+        _display.displayWindow(w.x0, w.y0, w.x1 - w.x0, w.y1 - w.y0);
+      }
+      break;
+    case REFRESH_FAST:
+      _display.displayBuffer(EInkDisplay::FAST_REFRESH);
+      break;
+    case REFRESH_FULL:
+      _display.displayBuffer(EInkDisplay::FULL_REFRESH);
+      break;
+  }
+
+  uint8_t* fb = _display.getFrameBuffer();
+  for (int b = 0; b < GHOST_BANDS; b++) {
+    if (!(_cleanBands >> b & 1)) continue;
+    int end = b + 1;
+    while (end < GHOST_BANDS && (_cleanBands >> end & 1)) end++;
+    uint8_t* p = &fb[b * GHOST_BAND_ROWS * kFbStride];
+    const int bytes = (end - b) * GHOST_BAND_ROWS * kFbStride;
+    for (int pass = 0; pass < 2; pass++) {
+      for (int i = 0; i < bytes; i++) p[i] = ~p[i];
+      _display.displayWindow(0, b * GHOST_BAND_ROWS, DISPLAY_W, (end - b) * GHOST_BAND_ROWS);
+    }
+    b = end;
+  }
+  _refresh = REFRESH_NONE;
+  _cleanBands = 0;
+}
+
+bool TermRenderer::renderDirty() {
+  drawDirty();
+  if (!commit()) return false;
+  present();
+  return true;
+}
+
+void TermRenderer::renderFull(bool panelMatches) {
+  drawFull(panelMatches);
+  commit();
+  present();
+}
+
+bool TermRenderer::cleanup() {
+  for (uint32_t g : _ghost) {
+    if (g >= GHOST_IDLE_MIN) {
+      _drawnPanel = REFRESH_FULL;
+      return true;
+    }
+  }
+  return false;
 }
 
 void TermRenderer::renderCursor() {
   if (!_cursorVisible) return;
 
   // Draw cursor as inverted block at current position
-  int row = _buf.cursorRow();
-  int col = _buf.cursorCol();
+  int row = _buf->cursorRow();
+  int col = _buf->cursorCol();
 
-  if (col >= TERM_COLS) col = TERM_COLS - 1;
+  if (col >= _buf->cols()) col = _buf->cols() - 1;
 
-  const TermCell& cell = _buf.cellAt(row, col);
-  const uint8_t* glyph = TermFont::getGlyph(cell.codepoint);
+  const TermCell& cell = _buf->cellAt(row, col);
+  const TermStyle& style = _buf->style(cell.style);
 
   // Cursor: invert the cell's effective background
-  uint8_t bgBright = cell.bgBright;
-  bool isInverse = (cell.attrs & TermCell::ATTR_INVERSE) != 0;
-  if (isInverse) bgBright = 255 - bgBright;
-  // Flip for cursor
-  bgBright = 255 - bgBright;
+  uint8_t bgBright = 255 - effectiveBg(style);
   bool invertGlyph = bgBright < 128;
 
-  blitGlyph(TERM_OFFSET_X + col * TERM_FONT_W, row * TERM_FONT_H,
-            glyph, bgBright, invertGlyph);
+  blitGlyph(_offsetX + col * _font->width, _offsetY + row * _font->height,
+            cell.codepoint, bgBright, invertGlyph, style.attrs & GLYPH_ATTRS);
 }
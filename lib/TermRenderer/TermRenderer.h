@@ -1,33 +1,159 @@
 #pragma once
+#include "GlyphCache.h"
 #include "TermBuffer.h"
+#include "TermFont.h"
 #include "term_config.h"
 #include <EInkDisplay.h>
 
 class TermRenderer {
  public:
   TermRenderer(EInkDisplay& display, TermBuffer& buf)
-      : _display(display), _buf(buf) {}
+      : _display(display), _buf(&buf) {
+    setLayout(TermFont::FONT_10X20, false);
+  }
 
-  // Render all dirty rows and refresh display
-  void renderDirty();
+  // Font (TermFont::Id) and orientation. Portrait turns the panel a
+  // quarter turn: the top of the text is along its right edge. The grid
+  // is as many cells as fit; resize the buffer to cols() x rows(), then
+  // renderFull().
+  void setLayout(uint8_t font, bool portrait);
+  uint8_t font() const { return _fontId; }
+  bool portrait() const { return _portrait; }
+  int cols() const { return _cols; }
+  int rows() const { return _rows; }
+  int cellWidth() const { return _font->width; }
+  int cellHeight() const { return _font->height; }
 
-  // Force full-screen render + full refresh (clear ghosting)
-  void renderFull();
+  // Show another buffer of the same size. Nothing is drawn: mark it all
+  // dirty and renderDirty(), which redraws only the cells that differ.
+  void setBuffer(TermBuffer& buf) { _buf = &buf; }
+
+  // Render all dirty rows and refresh display. Scrolled and shifted
+  // content is moved in the framebuffer rather than redrawn, and cells
+  // that still match what the panel shows are skipped; returns false if
+  // nothing changed and no refresh was sent.
+  bool renderDirty();
+
+  // Force full-screen render + full refresh (clear ghosting). If the
+  // panel already shows this screen (resuming from sleep), the redraw only
+  // rebuilds the framebuffer and goes out as one fast refresh.
+  void renderFull(bool panelMatches = false);
+
+  // The same in three steps, for a render task that leaves the panel to
+  // another task:
+  //   drawDirty()/drawFull() draw into the back buffer. They read the
+  //     terminal buffer, so hold whatever guards it. Draws add up.
+  //   commit() copies what was drawn to the panel's framebuffer and plans
+  //     its refresh; returns false if there is nothing new to show.
+  //   present() runs the planned refresh, blocking on the panel.
+  // commit() must wait for the last present() to finish. Without
+  // RENDER_BACK_BUFFER the panel's framebuffer is drawn into directly, so
+  // drawing must wait for it too.
+  bool drawDirty();
+  void drawFull(bool panelMatches = false);
+  bool commit();
+  void present();
+
+  // Damage small enough to show without waiting out the rate limit:
+  // nothing moved, at most ECHO_MAX_CELLS cells to redraw, and maybe the
+  // cursor. Typing at a prompt is one cell and the cursor. False if there
+  // is nothing to draw.
+  bool echoOnly() const;
+
+  // Plan a full refresh if any band has built up ghosting worth clearing;
+  // call while the host is quiet, then commit() and present(). Returns
+  // false if the panel can be left alone.
+  bool cleanup();
 
   // Render cursor at current position (XOR block)
   void renderCursor();
 
+  // Composed glyph cache, for its hit rate
+  const GlyphCache& glyphCache() const { return _glyphCache; }
+
   // Cursor visibility (set from VtParser's DECTCEM state)
   void setCursorVisible(bool v) { _cursorVisible = v; }
 
  private:
   EInkDisplay& _display;
-  TermBuffer& _buf;
-  int _fastRefreshCount = 0;
-  int _lastCursorRow = -1;
-  int _lastCursorCol = -1;
+  TermBuffer* _buf;
+  const TermFont::Face* _font;
+  uint8_t _fontId;
+  bool _portrait;
+  int _cols, _rows;
+  int _offsetX, _offsetY;    // grid origin, logical pixels
+  int _width, _height;       // logical panel size
+  int _baseline, _strikeRow;  // glyph rows: bottom of 'x', middle of 'x'
+  // Pixel transitions per band of panel rows since it was last clean
+  static constexpr int GHOST_BANDS = DISPLAY_H / GHOST_BAND_ROWS;
+  static_assert(DISPLAY_H % GHOST_BAND_ROWS == 0, "bands must tile the panel");
+  uint32_t _ghost[GHOST_BANDS] = {};
+  static_assert(GHOST_BANDS <= 32, "bands must fit a mask");
+
+#if RENDER_BACK_BUFFER
+  uint8_t _back[DISPLAY_W / 8 * DISPLAY_H];
+#endif
+  uint8_t* back() {
+#if RENDER_BACK_BUFFER
+    return _back;
+#else
+    return _display.getFrameBuffer();
+#endif
+  }
+
+  // How much of the panel a commit refreshes, in increasing order
+  enum Refresh : uint8_t { REFRESH_NONE, REFRESH_WINDOWS, REFRESH_FAST, REFRESH_FULL };
+  // Panel rectangle [x0, x1) x [y0, y1), x0 and x1 on byte boundaries
+  struct Window {
+    int x0, y0, x1, y1;
+  };
+
+  // Drawn since the last commit: a column span per row, and whether the
+  // whole panel was redrawn (fast or full refresh)
+  RowSet _drawn;
+  uint8_t _drawnMin[TERM_MAX_ROWS], _drawnMax[TERM_MAX_ROWS];
+  uint8_t _drawnPanel = REFRESH_NONE;
+
+  // Planned by commit() for present()
+  uint8_t _refresh = REFRESH_NONE;
+  Window _windows[REFRESH_MAX_WINDOWS];
+  int _windowCount = 0;
+  uint32_t _cleanBands = 0;  // bit per band to invert and restore
+
+  int _lastCursorRow = 0;
+  int _lastCursorCol = 0;
   bool _cursorVisible = true;
+  bool _cursorShown = false;  // cursor drawn at _lastCursorRow/Col
+
+  // What the panel shows in each cell, cursor aside: the glyph, its
+  // effective background and attributes (row-major, cols() per row).
+  // Filled by drawFull().
+  struct ShadowCell {
+    uint16_t codepoint;
+    uint8_t bg;
+    uint8_t attrs;  // GLYPH_ATTRS only
+  };
+  // Attributes that change a glyph's pixels
+  static constexpr uint8_t GLYPH_ATTRS =
+      TermStyle::ATTR_BOLD | TermStyle::ATTR_UNDERLINE | TermStyle::ATTR_DIM |
+      TermStyle::ATTR_ITALIC | TermStyle::ATTR_STRIKE | TermStyle::ATTR_HIDDEN;
+  ShadowCell _shadow[TERM_MAX_CELLS] = {};
+
+  GlyphCache _glyphCache;
 
-  void renderRow(int row);
-  void blitGlyph(int px, int py, const uint8_t* glyph, uint8_t bgBright, bool invertGlyph);
+  bool cursorMoved() const;
+  void renderRow(int row, int minCol, int maxCol);
+  bool diffRow(int row, uint8_t& minCol, uint8_t& maxCol);
+  void styleGlyph(uint32_t* ink, uint8_t attrs, bool drawn) const;
+  void composeGlyph(const uint32_t* ink, int level, bool invertGlyph, uint32_t* out) const;
+  void blitGlyph(int px, int py, uint16_t codepoint, uint8_t bgBright, bool invertGlyph,
+                 uint8_t attrs);
+  Window panelWindow(int x, int y, int w, int h) const;
+  static long windowCost(const Window& w);
+  static Window unite(const Window& a, const Window& b);
+  static int mergeWindows(Window* w, int n);
+  void planWindows();
+  void planCleaning();
+  void moveRect(int x, int y, int w, int h, int dx, int dy);
+  void applyMoves(RowSet& moved, uint8_t* minCol, uint8_t* maxCol);
 };
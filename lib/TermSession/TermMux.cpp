@@ -0,0 +1,25 @@
+#include "TermMux.h"
+
+size_t TermMux::encode(uint8_t session, const uint8_t* in, size_t n,
+                       uint8_t* out, size_t room, size_t& outLen) const {
+  outLen = 0;
+  if (!_active) {
+    size_t k = n < room ? n : room;
+    for (size_t i = 0; i < k; i++) out[i] = in[i];
+    outLen = k;
+    return k;
+  }
+
+  // Every chunk starts with its select: chunks of different sessions can
+  // be interleaved without tracking what the host last saw
+  out[outLen++] = DLE;
+  out[outLen++] = '0' + session;
+  size_t i = 0;
+  while (i < n) {
+    size_t need = in[i] == DLE ? 2 : 1;
+    if (outLen + need > room) break;
+    if (in[i] == DLE) out[outLen++] = DLE;
+    out[outLen++] = in[i++];
+  }
+  return i;
+}
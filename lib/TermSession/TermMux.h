@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Framing that carries several sessions over one serial link, in both
+// directions:
+//
+//   DLE '0'..'9'   following bytes belong to that session
+//   DLE DLE        a literal DLE
+//
+// DLE followed by anything else is passed through as is. A select of a
+// session the device does not have drops input until the next valid one.
+// A host that never sends a select is a plain terminal: its input goes to
+// session 0 and output is sent unframed.
+class TermMux {
+ public:
+  static constexpr uint8_t DLE = 0x10;
+
+  explicit TermMux(uint8_t sessions) : _count(sessions) {}
+
+  // Host has selected a session at least once
+  bool active() const { return _active; }
+
+  // Split serial input into per-session runs: sink(session, data, len)
+  template <typename Sink>
+  void feed(const uint8_t* data, size_t len, Sink&& sink);
+
+  // Frame up to n bytes of a session's output into out (room bytes, at
+  // least 4). Returns the input bytes consumed; outLen is what to send.
+  size_t encode(uint8_t session, const uint8_t* in, size_t n,
+                uint8_t* out, size_t room, size_t& outLen) const;
+
+ private:
+  uint8_t _count;
+  uint8_t _rx = 0;       // session receiving input; _count or more drops it
+  bool _active = false;
+  bool _escape = false;  // DLE seen, selector pending (may span blocks)
+};
+
+template <typename Sink>
+void TermMux::feed(const uint8_t* data, size_t len, Sink&& sink) {
+  static const uint8_t dle = DLE;
+  auto deliver = [&](const uint8_t* p, size_t n) {
+    if (_rx < _count) sink(_rx, p, n);
+  };
+  size_t run = 0;  // start of the pending run for _rx
+  for (size_t i = 0; i < len; i++) {
+    uint8_t b = data[i];
+    if (_escape) {
+      _escape = false;
+      run = i + 1;
+      if (b >= '0' && b <= '9') {
+        _rx = b - '0';
+        _active = true;
+        continue;
+      }
+      deliver(&dle, 1);
+      if (b != DLE) run = i;  // not a selector: deliver it as well
+      continue;
+    }
+    if (b == DLE) {
+      if (i > run) deliver(data + run, i - run);
+      _escape = true;
+    }
+  }
+  if (!_escape && len > run) deliver(data + run, len - run);
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Scrollback.h"
+#include "TermBuffer.h"
+#include "VtParser.h"
+#include "term_config.h"
+
+// One virtual console: a grid, its parser and its own scrollback.
+// Sessions are sized by the caller (resize()) like a lone TermBuffer.
+struct TermSession {
+  uint8_t historyMem[SCROLLBACK_BYTES];
+  Scrollback history;
+  TermBuffer buf;
+  VtParser parser;
+
+  TermSession() : history(historyMem, sizeof(historyMem)), buf(78, 24), parser(buf) {
+    buf.attachScrollback(&history);
+  }
+};
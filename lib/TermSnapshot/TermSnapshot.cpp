@@ -0,0 +1,146 @@
+#include "TermSnapshot.h"
+#include <cstring>
+
+namespace {
+
+uint32_t fnv1a(uint32_t h, const uint8_t* data, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    h ^= data[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+constexpr uint32_t FNV_OFFSET = 2166136261u;
+
+// Buffered sequential writer; erases each sector just before entering it
+class FlashWriter : public StateWriter {
+ public:
+  FlashWriter(HalStorage& storage, size_t offset) : _storage(storage), _pos(offset) {}
+
+  void write(const uint8_t* data, size_t n) override {
+    while (n > 0) {
+      size_t chunk = sizeof(_buf) - _fill < n ? sizeof(_buf) - _fill : n;
+      memcpy(&_buf[_fill], data, chunk);
+      _fill += chunk;
+      data += chunk;
+      n -= chunk;
+      if (_fill == sizeof(_buf)) flush();
+    }
+  }
+
+  bool flush() {
+    if (_fill == 0) return _ok;
+    _hash = fnv1a(_hash, _buf, _fill);
+    size_t end = _pos + _fill;
+    if (end > _storage.size()) _ok = false;
+    while (_ok && _erased < end) {
+      _ok = _storage.erase(_erased, HalStorage::SECTOR_SIZE);
+      _erased += HalStorage::SECTOR_SIZE;
+    }
+    if (_ok) _ok = _storage.write(_pos, _buf, _fill);
+    _pos = end;
+    _fill = 0;
+    return _ok;
+  }
+
+  bool ok() const { return _ok; }
+  size_t end() const { return _pos + _fill; }
+  uint32_t hash() const { return _hash; }
+
+ private:
+  HalStorage& _storage;
+  size_t _pos;
+  size_t _erased = HalStorage::SECTOR_SIZE;  // sector 0 is erased up front
+  uint8_t _buf[256];
+  size_t _fill = 0;
+  uint32_t _hash = FNV_OFFSET;
+  bool _ok = true;
+};
+
+class FlashReader : public StateReader {
+ public:
+  FlashReader(HalStorage& storage, size_t offset, size_t len)
+      : _storage(storage), _pos(offset), _end(offset + len) {}
+
+  bool read(uint8_t* data, size_t n) override {
+    if (n > _end - _pos || !_storage.read(_pos, data, n)) return false;
+    _pos += n;
+    return true;
+  }
+
+ private:
+  HalStorage& _storage;
+  size_t _pos, _end;
+};
+
+uint32_t get32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24); }
+
+void put32(uint8_t* p, uint32_t v) {
+  for (int i = 0; i < 4; i++) p[i] = v >> (8 * i);
+}
+
+}  // namespace
+
+bool TermSnapshot::save(uint8_t font, bool portrait, const TermSession* sessions, int count,
+                        uint8_t foreground) {
+  if (!_storage.erase(0, HalStorage::SECTOR_SIZE)) return false;
+  FlashWriter w(_storage, HEADER_SIZE);
+  w.u8(count);
+  w.u8(foreground);
+  for (int i = 0; i < count; i++) {
+    sessions[i].buf.save(w);
+    sessions[i].parser.save(w);
+    sessions[i].history.save(w);
+  }
+  if (!w.flush()) return false;
+
+  uint8_t header[HEADER_SIZE] = {};
+  put32(&header[0], MAGIC);
+  header[4] = VERSION;
+  header[5] = font;
+  header[6] = portrait;
+  put32(&header[8], w.end() - HEADER_SIZE);
+  put32(&header[12], w.hash());
+  return _storage.write(0, header, sizeof(header));
+}
+
+bool TermSnapshot::probe(uint8_t& font, bool& portrait) {
+  uint8_t header[HEADER_SIZE];
+  if (!_storage.read(0, header, sizeof(header))) return false;
+  if (get32(&header[0]) != MAGIC || header[4] != VERSION) return false;
+  _len = get32(&header[8]);
+  if (_len > _storage.size() - HEADER_SIZE) return false;
+
+  uint8_t chunk[256];
+  uint32_t hash = FNV_OFFSET;
+  for (size_t pos = 0; pos < _len;) {
+    size_t n = _len - pos < sizeof(chunk) ? _len - pos : sizeof(chunk);
+    if (!_storage.read(HEADER_SIZE + pos, chunk, n)) return false;
+    hash = fnv1a(hash, chunk, n);
+    pos += n;
+  }
+  if (hash != get32(&header[12])) return false;
+  font = header[5];
+  portrait = header[6];
+  return true;
+}
+
+bool TermSnapshot::restore(TermSession* sessions, int count, uint8_t& foreground) {
+  FlashReader r(_storage, HEADER_SIZE, _len);
+  int saved = r.u8();
+  foreground = r.u8();
+  if (saved != count || foreground >= count) return false;
+  for (int i = 0; i < count; i++) {
+    TermSession& s = sessions[i];
+    if (!s.buf.restore(r) || !s.parser.restore(r) || !s.history.restore(r)) return false;
+  }
+  return true;
+}
+
+void TermSnapshot::invalidate() {
+  uint8_t magic[4];
+  if (_storage.read(0, magic, sizeof(magic)) && get32(magic) != 0xFFFFFFFF) {
+    _storage.erase(0, HalStorage::SECTOR_SIZE);
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "HalStorage.h"
+#include "TermSession.h"
+
+// Terminal state kept in flash across deep sleep, so wake-up can resume
+// the sessions on the image the panel still shows.
+//
+// Layout in the storage partition:
+//
+//   0   magic:u32 version:u8 font:u8 portrait:u8 0:u8 len:u32 hash:u32
+//   16  count:u8 foreground:u8, then per session TermBuffer, VtParser
+//       and Scrollback state (len bytes, FNV-1a hash)
+//
+// The header is written last, so a save cut short leaves no snapshot.
+class TermSnapshot {
+ public:
+  explicit TermSnapshot(HalStorage& storage) : _storage(storage) {}
+
+  bool save(uint8_t font, bool portrait, const TermSession* sessions, int count,
+            uint8_t foreground);
+
+  // A complete snapshot is stored: the layout it was taken with. The
+  // caller applies that layout, then restore()s into it.
+  bool probe(uint8_t& font, bool& portrait);
+  bool restore(TermSession* sessions, int count, uint8_t& foreground);
+
+  // Forget the stored snapshot (it is only good for one wake-up)
+  void invalidate();
+
+ private:
+  static constexpr uint32_t MAGIC = 0x53543458;  // "X4TS"
+  static constexpr uint8_t VERSION = 2;
+  static constexpr size_t HEADER_SIZE = 16;
+
+  HalStorage& _storage;
+  uint32_t _len = 0;  // payload length, after probe()
+};
@@ -0,0 +1,37 @@
+#include "ReplyQueue.h"
+#include <cstdarg>
+#include <cstdio>
+
+bool ReplyQueue::push(const char* data, size_t len) {
+  if (len > CAPACITY - size()) {
+    _dropped++;
+    return false;
+  }
+  for (size_t i = 0; i < len; i++) {
+    _buf[(_head + i) & (CAPACITY - 1)] = (uint8_t)data[i];
+  }
+  _head += len;
+  return true;
+}
+
+bool ReplyQueue::printf(const char* fmt, ...) {
+  char tmp[64];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+  va_end(ap);
+  if (n < 0 || n >= (int)sizeof(tmp)) {
+    _dropped++;
+    return false;
+  }
+  return push(tmp, n);
+}
+
+size_t ReplyQueue::peek(const uint8_t** data) const {
+  size_t pending = size();
+  if (pending == 0) return 0;
+  size_t start = _tail & (CAPACITY - 1);
+  size_t run = CAPACITY - start;
+  *data = &_buf[start];
+  return pending < run ? pending : run;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Bounded ring of outbound bytes (replies to DSR, DA, DECRQM, ...).
+//
+// The parser appends whole replies; the main loop drains it in batches as
+// the serial TX path has room, so a slow host never stalls parsing. A reply
+// that doesn't fit is dropped whole rather than sent truncated.
+class ReplyQueue {
+ public:
+  static constexpr size_t CAPACITY = 256;  // power of two
+
+  // Append a complete reply; returns false (and drops it) if it won't fit
+  bool push(const char* data, size_t len);
+  bool push(const char* str) { return push(str, strlen(str)); }
+  bool printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+  // Longest contiguous run of pending bytes; 0 when empty
+  size_t peek(const uint8_t** data) const;
+  void consume(size_t n) { _tail += n; }
+
+  bool empty() const { return _head == _tail; }
+  size_t size() const { return _head - _tail; }
+  size_t dropped() const { return _dropped; }
+
+ private:
+  uint8_t _buf[CAPACITY];
+  size_t _head = 0;  // write position (free-running)
+  size_t _tail = 0;  // read position (free-running)
+  size_t _dropped = 0;
+};
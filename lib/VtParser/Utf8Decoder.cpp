@@ -0,0 +1,54 @@
+#include "Utf8Decoder.h"
+
+uint32_t Utf8Decoder::step(uint8_t byte, bool& reprocess) {
+  if (_need == 0) {
+    if (byte < 0x80) return byte;
+    _lo = 0x80;
+    _hi = 0xBF;
+    if (byte < 0xC2) {
+      // Stray continuation byte or overlong 2-byte lead (C0/C1)
+      return REPLACEMENT;
+    } else if (byte < 0xE0) {
+      _cp = byte & 0x1F;
+      _need = 1;
+    } else if (byte < 0xF0) {
+      _cp = byte & 0x0F;
+      _need = 2;
+      if (byte == 0xE0) _lo = 0xA0;  // overlong
+      if (byte == 0xED) _hi = 0x9F;  // surrogates
+    } else if (byte < 0xF5) {
+      _cp = byte & 0x07;
+      _need = 3;
+      if (byte == 0xF0) _lo = 0x90;  // overlong
+      if (byte == 0xF4) _hi = 0x8F;  // above U+10FFFF
+    } else {
+      return REPLACEMENT;
+    }
+    return NEED_MORE;
+  }
+
+  if (byte < _lo || byte > _hi) {
+    // Sequence cut short: replace it and let the caller retry this byte
+    _need = 0;
+    reprocess = true;
+    return REPLACEMENT;
+  }
+  _lo = 0x80;
+  _hi = 0xBF;
+  _cp = (_cp << 6) | (byte & 0x3F);
+  if (--_need) return NEED_MORE;
+  return _cp;
+}
+
+const uint8_t* Utf8Decoder::scanPrintable(const uint8_t* p, const uint8_t* end) {
+  // Four bytes per test: stop on any byte >= 0x80, < 0x20 or == 0x7F
+  while (end - p >= 4) {
+    uint32_t w = load32(p);
+    uint32_t del = w ^ 0x7F7F7F7F;
+    uint32_t bad = w | ((w - 0x20202020) & ~w) | ((del - 0x01010101) & ~del);
+    if (bad & 0x80808080) break;
+    p += 4;
+  }
+  while (p < end && *p >= 0x20 && *p < 0x7F) p++;
+  return p;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "SWAR decoding assumes little-endian words");
+
+// Validating UTF-8 decoder.
+//
+// step() decodes one byte at a time and carries a partial sequence across
+// calls (and therefore across serial chunks). Overlong forms, surrogates,
+// code points above U+10FFFF and truncated sequences become U+FFFD, one per
+// maximal invalid subpart.
+//
+// scanPrintable() and decodeRun() are the bulk helpers: they work on 32-bit
+// words, skipping four printable ASCII bytes per test and decoding a whole
+// 2/3/4-byte sequence per load. Anything they can't handle in one word is
+// left for step().
+class Utf8Decoder {
+ public:
+  static constexpr uint32_t REPLACEMENT = 0xFFFD;
+  static constexpr uint32_t NEED_MORE = 0xFFFFFFFF;
+
+  // Decode one byte. Returns a code point, or NEED_MORE while a sequence is
+  // incomplete. If the byte cannot continue the pending sequence, returns
+  // REPLACEMENT and sets reprocess: the caller must feed the byte again.
+  uint32_t step(uint8_t byte, bool& reprocess);
+
+  // True while a multibyte sequence is partially decoded
+  bool pending() const { return _need != 0; }
+
+  // Drop the pending sequence (caller emits REPLACEMENT if it was pending)
+  void reset() { _need = 0; }
+
+  // Return the end of the run of printable ASCII (0x20-0x7E) starting at p
+  static const uint8_t* scanPrintable(const uint8_t* p, const uint8_t* end);
+
+  // Decode consecutive well-formed multibyte sequences starting at p,
+  // calling sink(cp) for each. Stops at ASCII, at anything invalid, or when
+  // fewer than 4 bytes remain; returns where it stopped.
+  template <typename Sink>
+  static const uint8_t* decodeRun(const uint8_t* p, const uint8_t* end, Sink&& sink);
+
+ private:
+  uint32_t _cp = 0;
+  uint8_t _need = 0;    // continuation bytes still expected
+  uint8_t _lo = 0x80;   // valid range for the next continuation byte
+  uint8_t _hi = 0xBF;
+
+  static uint32_t load32(const uint8_t* p) {
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+  }
+};
+
+template <typename Sink>
+const uint8_t* Utf8Decoder::decodeRun(const uint8_t* p, const uint8_t* end, Sink&& sink) {
+  while (end - p >= 4) {
+    uint32_t w = load32(p);
+    uint32_t cp;
+    if ((w & 0xC0E0) == 0x80C0) {
+      // 110xxxxx 10xxxxxx
+      cp = ((w & 0x1F) << 6) | ((w >> 8) & 0x3F);
+      if (cp < 0x80) break;
+      p += 2;
+    } else if ((w & 0xC0C0F0) == 0x8080E0) {
+      // 1110xxxx 10xxxxxx 10xxxxxx (box drawing, blocks, Braille, ...)
+      cp = ((w & 0x0F) << 12) | ((w >> 2) & 0x0FC0) | ((w >> 16) & 0x3F);
+      if (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF)) break;
+      p += 3;
+    } else if ((w & 0xC0C0C0F8) == 0x808080F0) {
+      // 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+      cp = ((w & 0x07) << 18) | ((w << 4) & 0x3F000) | ((w >> 10) & 0x0FC0) | ((w >> 24) & 0x3F);
+      if (cp < 0x10000 || cp > 0x10FFFF) break;
+      p += 4;
+    } else {
+      break;
+    }
+    sink(cp);
+  }
+  return p;
+}
@@ -1,59 +1,293 @@
 #include "VtParser.h"
-#include <Arduino.h>
-#include <cstdio>
+#include <cstring>
+#include <initializer_list>
 
-void VtParser::resetParams() {
-  for (int i = 0; i < MAX_PARAMS; i++) _params[i] = 0;
-  _paramCount = 0;
-  _questionMark = false;
-  _hasIntermediate = false;
-  _csiPrefix = 0;
+// ---------------------------------------------------------------------------
+// Transition table
+//
+// One byte per (state, input byte): high nibble = action, low nibble = next
+// state. Built at compile time from the DEC ANSI parser diagram. Bytes
+// 0x80-0xFF are UTF-8 in Ground and ignored elsewhere (no 8-bit C1 controls).
+// ---------------------------------------------------------------------------
+
+namespace {
+
+using State = VtParser::State;
+
+enum Action : uint8_t {
+  A_NONE,
+  A_PRINT,
+  A_EXECUTE,
+  A_CLEAR,
+  A_COLLECT,
+  A_PARAM,
+  A_ESC_DISPATCH,
+  A_CSI_DISPATCH,
+  A_HOOK,
+  A_PUT,
+  A_UNHOOK,
+};
+
+constexpr int kStateCount = (int)State::Count;
+
+struct TransitionTable {
+  uint8_t t[kStateCount][256] = {};
+
+  constexpr void set(State s, int lo, int hi, Action a, State next) {
+    for (int b = lo; b <= hi; b++) t[(int)s][b] = (uint8_t)((a << 4) | (int)next);
+  }
+  constexpr void stay(State s, int lo, int hi, Action a) { set(s, lo, hi, a, s); }
+
+  // C0 controls other than CAN, SUB and ESC (those are handled "anywhere")
+  constexpr void c0(State s, Action a) {
+    stay(s, 0x00, 0x17, a);
+    stay(s, 0x19, 0x19, a);
+    stay(s, 0x1C, 0x1F, a);
+  }
+};
+
+constexpr TransitionTable buildTransitions() {
+  TransitionTable tt;
+
+  // Default: ignore and stay (covers DEL and high bytes outside Ground)
+  for (int s = 0; s < kStateCount; s++) tt.stay((State)s, 0x00, 0xFF, A_NONE);
+
+  tt.c0(State::Ground, A_EXECUTE);
+  tt.stay(State::Ground, 0x20, 0x7E, A_PRINT);
+  tt.stay(State::Ground, 0x80, 0xFF, A_PRINT);
+
+  tt.c0(State::Escape, A_EXECUTE);
+  tt.set(State::Escape, 0x20, 0x2F, A_COLLECT, State::EscapeIntermediate);
+  tt.set(State::Escape, 0x30, 0x7E, A_ESC_DISPATCH, State::Ground);
+  tt.set(State::Escape, 'P', 'P', A_CLEAR, State::DcsEntry);
+  tt.set(State::Escape, '[', '[', A_CLEAR, State::CsiEntry);
+  tt.set(State::Escape, ']', ']', A_NONE, State::OscString);
+  tt.set(State::Escape, 'X', 'X', A_NONE, State::SosPmApcString);
+  tt.set(State::Escape, '^', '_', A_NONE, State::SosPmApcString);
+
+  tt.c0(State::EscapeIntermediate, A_EXECUTE);
+  tt.stay(State::EscapeIntermediate, 0x20, 0x2F, A_COLLECT);
+  tt.set(State::EscapeIntermediate, 0x30, 0x7E, A_ESC_DISPATCH, State::Ground);
+
+  tt.c0(State::CsiEntry, A_EXECUTE);
+  tt.set(State::CsiEntry, 0x20, 0x2F, A_COLLECT, State::CsiIntermediate);
+  tt.set(State::CsiEntry, 0x30, 0x39, A_PARAM, State::CsiParam);
+  tt.set(State::CsiEntry, 0x3A, 0x3A, A_NONE, State::CsiIgnore);
+  tt.set(State::CsiEntry, 0x3B, 0x3B, A_PARAM, State::CsiParam);
+  tt.set(State::CsiEntry, 0x3C, 0x3F, A_COLLECT, State::CsiParam);
+  tt.set(State::CsiEntry, 0x40, 0x7E, A_CSI_DISPATCH, State::Ground);
+
+  tt.c0(State::CsiParam, A_EXECUTE);
+  tt.set(State::CsiParam, 0x20, 0x2F, A_COLLECT, State::CsiIntermediate);
+  tt.stay(State::CsiParam, 0x30, 0x39, A_PARAM);
+  tt.set(State::CsiParam, 0x3A, 0x3A, A_NONE, State::CsiIgnore);
+  tt.stay(State::CsiParam, 0x3B, 0x3B, A_PARAM);
+  tt.set(State::CsiParam, 0x3C, 0x3F, A_NONE, State::CsiIgnore);
+  tt.set(State::CsiParam, 0x40, 0x7E, A_CSI_DISPATCH, State::Ground);
+
+  tt.c0(State::CsiIntermediate, A_EXECUTE);
+  tt.stay(State::CsiIntermediate, 0x20, 0x2F, A_COLLECT);
+  tt.set(State::CsiIntermediate, 0x30, 0x3F, A_NONE, State::CsiIgnore);
+  tt.set(State::CsiIntermediate, 0x40, 0x7E, A_CSI_DISPATCH, State::Ground);
+
+  tt.c0(State::CsiIgnore, A_EXECUTE);
+  tt.set(State::CsiIgnore, 0x40, 0x7E, A_NONE, State::Ground);
+
+  tt.set(State::DcsEntry, 0x20, 0x2F, A_COLLECT, State::DcsIntermediate);
+  tt.set(State::DcsEntry, 0x30, 0x39, A_PARAM, State::DcsParam);
+  tt.set(State::DcsEntry, 0x3A, 0x3A, A_NONE, State::DcsIgnore);
+  tt.set(State::DcsEntry, 0x3B, 0x3B, A_PARAM, State::DcsParam);
+  tt.set(State::DcsEntry, 0x3C, 0x3F, A_COLLECT, State::DcsParam);
+  tt.set(State::DcsEntry, 0x40, 0x7E, A_HOOK, State::DcsPassthrough);
+
+  tt.set(State::DcsParam, 0x20, 0x2F, A_COLLECT, State::DcsIntermediate);
+  tt.stay(State::DcsParam, 0x30, 0x39, A_PARAM);
+  tt.set(State::DcsParam, 0x3A, 0x3A, A_NONE, State::DcsIgnore);
+  tt.stay(State::DcsParam, 0x3B, 0x3B, A_PARAM);
+  tt.set(State::DcsParam, 0x3C, 0x3F, A_NONE, State::DcsIgnore);
+  tt.set(State::DcsParam, 0x40, 0x7E, A_HOOK, State::DcsPassthrough);
+
+  tt.stay(State::DcsIntermediate, 0x20, 0x2F, A_COLLECT);
+  tt.set(State::DcsIntermediate, 0x30, 0x3F, A_NONE, State::DcsIgnore);
+  tt.set(State::DcsIntermediate, 0x40, 0x7E, A_HOOK, State::DcsPassthrough);
+
+  tt.c0(State::DcsPassthrough, A_PUT);
+  tt.stay(State::DcsPassthrough, 0x20, 0x7E, A_PUT);
+
+  // OSC (titles, palette) has no meaning on this display: consume until
+  // BEL or ST. ESC leaves via the "anywhere" rule, so ESC \ ends in Escape
+  // and the backslash is dispatched as ST rather than printed.
+  tt.set(State::OscString, 0x07, 0x07, A_NONE, State::Ground);
+
+  // Anywhere: CAN/SUB abort to Ground, ESC starts a new sequence
+  for (int s = 0; s < kStateCount; s++) {
+    tt.set((State)s, 0x18, 0x18, A_EXECUTE, State::Ground);
+    tt.set((State)s, 0x1A, 0x1A, A_EXECUTE, State::Ground);
+    tt.set((State)s, 0x1B, 0x1B, A_CLEAR, State::Escape);
+  }
+  // Leaving passthrough (ST or cancel) ends the DCS string
+  tt.set(State::DcsPassthrough, 0x18, 0x18, A_UNHOOK, State::Ground);
+  tt.set(State::DcsPassthrough, 0x1A, 0x1A, A_UNHOOK, State::Ground);
+  tt.set(State::DcsPassthrough, 0x1B, 0x1B, A_UNHOOK, State::Escape);
+  return tt;
 }
 
+constexpr TransitionTable kTransitions = buildTransitions();
+
+// ---------------------------------------------------------------------------
+// Character sets: 7-bit translation tables for ESC ( F and friends
+// ---------------------------------------------------------------------------
+
+enum Charset : uint8_t {
+  CS_ASCII,         // ESC ( B
+  CS_DEC_GRAPHICS,  // ESC ( 0 - DEC Special Graphics (line drawing)
+  CS_UK,            // ESC ( A
+  CS_COUNT,
+};
+
+struct CharsetMap {
+  uint16_t cp[128] = {};
+};
+
+constexpr CharsetMap buildCharset(Charset cs) {
+  CharsetMap m;
+  for (int c = 0; c < 128; c++) m.cp[c] = c;
+  if (cs == CS_UK) {
+    m.cp['#'] = 0x00A3;
+  } else if (cs == CS_DEC_GRAPHICS) {
+    constexpr uint16_t kDecGraphics[32] = {
+      0x00A0,                                          // _ blank
+      0x25C6, 0x2592, 0x2409, 0x240C, 0x240D, 0x240A,  // ` a b c d e
+      0x00B0, 0x00B1, 0x2424, 0x240B,                  // f g h i
+      0x2518, 0x2510, 0x250C, 0x2514, 0x253C,          // j k l m n  corners, cross
+      0x23BA, 0x23BB, 0x2500, 0x23BC, 0x23BD,          // o p q r s  scan lines
+      0x251C, 0x2524, 0x2534, 0x252C, 0x2502,          // t u v w x  tees, vertical
+      0x2264, 0x2265, 0x03C0, 0x2260, 0x00A3, 0x00B7,  // y z { | } ~
+    };
+    for (int i = 0; i < 32; i++) m.cp[0x5F + i] = kDecGraphics[i];
+  }
+  return m;
+}
+
+constexpr CharsetMap kDecGraphicsMap = buildCharset(CS_DEC_GRAPHICS);
+constexpr CharsetMap kUkMap = buildCharset(CS_UK);
+
+// Translation table per charset; nullptr = identity (ASCII fast path)
+constexpr const uint16_t* kCharsetMaps[CS_COUNT] = {
+  nullptr,
+  kDecGraphicsMap.cp,
+  kUkMap.cp,
+};
+
+}  // namespace
+
 int VtParser::param(int idx, int def) const {
   if (idx >= _paramCount) return def;
   return _params[idx] == 0 ? def : _params[idx];
 }
 
 void VtParser::feed(uint8_t byte) {
-  switch (_state) {
-    case State::Ground:    handleGround(byte);  break;
-    case State::Escape:    handleEscape(byte);   break;
-    case State::CsiEntry:  handleCsiEntry(byte); break;
-    case State::CsiParam:  handleCsiParam(byte); break;
-    case State::OscString:
-      // Consume until ST (ESC \) or BEL
-      if (byte == 0x07 || byte == 0x1B) _state = State::Ground;
-      break;
-    case State::EscSwallow:
-      // Swallow one byte (charset designation parameter) and return to ground
-      _state = State::Ground;
-      break;
+  uint8_t tr = kTransitions.t[(int)_state][byte];
+  switch (tr >> 4) {
+    case A_PRINT:        print(byte); break;
+    case A_EXECUTE:      execute(byte); break;
+    case A_CLEAR:        clear(); break;
+    case A_COLLECT:      collect(byte); break;
+    case A_PARAM:        paramByte(byte); break;
+    case A_ESC_DISPATCH: dispatchEsc(byte); break;
+    case A_CSI_DISPATCH: dispatchCsi(byte); break;
+    case A_HOOK:         hook(byte); break;
+    case A_PUT:          put(byte); break;
+    case A_UNHOOK:       unhook(); break;
+    default: break;
   }
+  _state = (State)(tr & 0x0F);
 }
 
-void VtParser::handleGround(uint8_t byte) {
-  // UTF-8 continuation byte
-  if (_utf8Remaining > 0) {
-    if ((byte & 0xC0) == 0x80) {
-      _utf8Cp = (_utf8Cp << 6) | (byte & 0x3F);
-      _utf8Remaining--;
-      if (_utf8Remaining == 0) {
-        _buf.putChar((uint16_t)_utf8Cp);
+void VtParser::feed(const uint8_t* data, size_t len) {
+  const uint8_t* p = data;
+  const uint8_t* end = data + len;
+  while (p < end) {
+    if (_state == State::Ground && !_utf8.pending() && !_singleShift) {
+      // Scan ahead for a run of printable ASCII
+      const uint8_t* run = p;
+      p = Utf8Decoder::scanPrintable(p, end);
+      if (p != run) {
+        _buf.putChars(run, p - run, _glMap);
+        continue;
+      }
+      // ... or a run of complete multibyte sequences
+      if (*p >= 0x80) {
+        p = Utf8Decoder::decodeRun(p, end, [this](uint32_t cp) { putCodepoint(cp); });
+        if (p != run) continue;
       }
-      return;
     }
-    // Invalid continuation - reset and fall through
-    _utf8Remaining = 0;
+    feed(*p++);
   }
+}
 
-  if (byte == 0x1B) {
-    _state = State::Escape;
-    return;
+void VtParser::print(uint8_t byte) {
+  bool reprocess;
+  do {
+    reprocess = false;
+    uint32_t cp = _utf8.step(byte, reprocess);
+    if (cp == Utf8Decoder::NEED_MORE) continue;
+    putCodepoint(cp < 0x80 ? translate(cp) : cp);
+  } while (reprocess);
+}
+
+void VtParser::putCodepoint(uint32_t cp) {
+  // Cells hold BMP code points; there are no glyphs beyond it
+  _buf.putChar(cp > 0xFFFF ? Utf8Decoder::REPLACEMENT : (uint16_t)cp);
+}
+
+uint16_t VtParser::translate(uint8_t c) {
+  const uint16_t* map = _glMap;
+  if (_singleShift) {
+    map = kCharsetMaps[_cs.g[_singleShift]];
+    _singleShift = 0;
+  }
+  return map ? map[c] : c;
+}
+
+void VtParser::designateCharset(int g, uint8_t final) {
+  switch (final) {
+    case 'B': _cs.g[g] = CS_ASCII; break;
+    case '0': _cs.g[g] = CS_DEC_GRAPHICS; break;
+    case 'A': _cs.g[g] = CS_UK; break;
+    default: return;  // unsupported set: keep the current designation
+  }
+  invokeCharset(_cs.gl);
+}
+
+void VtParser::invokeCharset(int g) {
+  _cs.gl = g;
+  _glMap = kCharsetMaps[_cs.g[g]];
+}
+
+// DECSC/DECRC also save and restore the charset state
+void VtParser::saveCursor() {
+  _buf.saveCursor();
+  _savedCs = _cs;
+}
+
+void VtParser::restoreCursor() {
+  _buf.restoreCursor();
+  _cs = _savedCs;
+  invokeCharset(_cs.gl);
+}
+
+void VtParser::flushUtf8() {
+  // A control or escape interrupted a multibyte sequence
+  if (_utf8.pending()) {
+    _utf8.reset();
+    _buf.putChar(Utf8Decoder::REPLACEMENT);
   }
+}
 
+void VtParser::execute(uint8_t byte) {
+  flushUtf8();
   switch (byte) {
-    case 0x07: break;                 // BEL - ignore
     case 0x08: _buf.backspace(); break;  // BS
     case 0x09: _buf.tab(); break;        // HT
     case 0x0A: // LF
@@ -62,157 +296,178 @@ void VtParser::handleGround(uint8_t byte) {
       _buf.lineFeed();
       break;
     case 0x0D: _buf.carriageReturn(); break;  // CR
-    default:
-      if (byte >= 0x20 && byte < 0x7F) {
-        _buf.putChar(byte);
-      } else if (byte >= 0xC0 && byte < 0xE0) {
-        // UTF-8 2-byte sequence start
-        _utf8Cp = byte & 0x1F;
-        _utf8Remaining = 1;
-      } else if (byte >= 0xE0 && byte < 0xF0) {
-        // UTF-8 3-byte sequence start (BMP: U+0800-U+FFFF)
-        _utf8Cp = byte & 0x0F;
-        _utf8Remaining = 2;
-      } else if (byte >= 0xF0 && byte < 0xF8) {
-        // UTF-8 4-byte sequence start (>BMP, will truncate to 16-bit)
-        _utf8Cp = byte & 0x07;
-        _utf8Remaining = 3;
-      }
-      break;
+    case 0x0E: invokeCharset(1); break;       // SO - G1 into GL
+    case 0x0F: invokeCharset(0); break;       // SI - G0 into GL
+    default: break;  // BEL, NUL, CAN, SUB, ... - ignore
   }
 }
 
-void VtParser::handleEscape(uint8_t byte) {
-  switch (byte) {
-    case '[':
-      _state = State::CsiEntry;
-      resetParams();
-      break;
-    case ']':
-      _state = State::OscString;
-      break;
+void VtParser::clear() {
+  for (int i = 0; i < MAX_PARAMS; i++) _params[i] = 0;
+  _paramCount = 0;
+  _privMarker = 0;
+  _intermediate = 0;
+  flushUtf8();
+}
+
+void VtParser::collect(uint8_t byte) {
+  if (byte >= 0x3C) {
+    _privMarker = byte;
+  } else if (_intermediate == 0) {
+    _intermediate = byte;
+  } else {
+    _intermediate = INTERMEDIATE_OVERFLOW;
+  }
+}
+
+void VtParser::paramByte(uint8_t byte) {
+  if (_paramCount == 0) _paramCount = 1;
+  if (byte == ';') {
+    if (_paramCount < MAX_PARAMS) _paramCount++;
+    return;
+  }
+  int& p = _params[_paramCount - 1];
+  p = p * 10 + (byte - '0');
+  if (p > MAX_PARAM_VALUE) p = MAX_PARAM_VALUE;
+}
+
+void VtParser::dispatchEsc(uint8_t final) {
+  switch (_intermediate) {
+    case 0: break;
+    case '(': designateCharset(0, final); return;  // G0
+    case ')': designateCharset(1, final); return;  // G1
+    case '*': designateCharset(2, final); return;  // G2
+    case '+': designateCharset(3, final); return;  // G3
+    case '#':
+      if (final == '8') {  // DECALN - fill with 'E', reset the margins, home
+        _buf.fillRect(0, 0, _buf.rows() - 1, _buf.cols() - 1, 'E');
+        _buf.setScrollRegion(0, _buf.rows() - 1);
+        _buf.setCursor(0, 0);
+      }
+      return;
+    default: return;
+  }
+
+  switch (final) {
     case 'D':  // IND - index (move down, scroll if at bottom)
       _buf.lineFeed();
-      _state = State::Ground;
+      break;
+    case 'E':  // NEL - next line
+      _buf.carriageReturn();
+      _buf.lineFeed();
       break;
     case 'M':  // RI - reverse index (move up, scroll if at top)
       _buf.reverseIndex();
-      _state = State::Ground;
       break;
     case '7':  // DECSC - save cursor
-      _buf.saveCursor();
-      _state = State::Ground;
+      saveCursor();
       break;
     case '8':  // DECRC - restore cursor
-      _buf.restoreCursor();
-      _state = State::Ground;
+      restoreCursor();
       break;
+    case 'N': _singleShift = 2; break;  // SS2
+    case 'O': _singleShift = 3; break;  // SS3
+    case 'n': invokeCharset(2); break;  // LS2
+    case 'o': invokeCharset(3); break;  // LS3
     case 'c':  // RIS - full reset
       _buf.eraseDisplay(2);
       _buf.setCursor(0, 0);
       _buf.resetAttrs();
-      _buf.setScrollRegion(0, TERM_ROWS - 1);
-      _state = State::Ground;
+      _buf.setScrollRegion(0, _buf.rows() - 1);
+      _cursorVisible = true;
+      endSyncFrame();
+      _reportResize = false;
+      _cs = Charsets();
+      _singleShift = 0;
+      invokeCharset(0);
       break;
-    case '=':  // DECKPAM - keypad application mode (ignore)
-    case '>':  // DECKPNM - keypad numeric mode (ignore)
-      _state = State::Ground;
+    default:  // ST, DECKPAM, DECKPNM, ... - ignore
       break;
-    case '(':  // G0 charset designation - consume next byte
-    case ')':  // G1 charset designation - consume next byte
-    case '#':  // DEC line drawing - consume next byte
-    case '*':  // G2 charset designation - consume next byte
-    case '+':  // G3 charset designation - consume next byte
-      _state = State::EscSwallow;
+  }
+}
+
+void VtParser::endSyncFrame() {
+  if (_syncOutput) _syncFrames++;
+  _syncOutput = false;
+}
+
+void VtParser::setPrivateMode(int mode, bool on) {
+  switch (mode) {
+    case 25: _cursorVisible = on; break;  // DECTCEM
+    case 47:    // alt screen (simple)
+    case 1047:  // alt screen
+    case 1049:  // alt screen + save cursor
+      if (on) {
+        if (mode == 1049) saveCursor();
+        _buf.switchScreen(true);
+      } else {
+        _buf.switchScreen(false);
+        if (mode == 1049) restoreCursor();
+      }
+      break;
+    case 2026:  // synchronized output
+      if (on) _syncOutput = true;
+      else endSyncFrame();
       break;
-    default:
-      _state = State::Ground;
+    case 2048:  // in-band resize notifications, starting with the current size
+      _reportResize = on;
+      if (on) reportResize();
       break;
   }
 }
 
-void VtParser::handleCsiEntry(uint8_t byte) {
-  if (byte == '?') {
-    _questionMark = true;
-    _state = State::CsiParam;
-    return;
-  }
-  // Handle other parameter prefix bytes (>, =, <)
-  if (byte == '>' || byte == '=' || byte == '<') {
-    _csiPrefix = byte;
-    _state = State::CsiParam;
-    return;
+void VtParser::reportPrivateMode(int mode) {
+  // DECRPM values: 0=not recognized, 1=set, 2=reset
+  int state;
+  switch (mode) {
+    case 25: state = _cursorVisible ? 1 : 2; break;
+    case 47:
+    case 1047:
+    case 1049: state = _buf.isAltScreen() ? 1 : 2; break;
+    case 2026: state = _syncOutput ? 1 : 2; break;
+    case 2048: state = _reportResize ? 1 : 2; break;
+    default: state = 0; break;
   }
-  // Fall through to param handling
-  _state = State::CsiParam;
-  handleCsiParam(byte);
+  _replies.printf("\033[?%d;%d$y", mode, state);
 }
 
-void VtParser::handleCsiParam(uint8_t byte) {
-  if (byte >= '0' && byte <= '9') {
-    if (_paramCount == 0) _paramCount = 1;
-    _params[_paramCount - 1] = _params[_paramCount - 1] * 10 + (byte - '0');
+void VtParser::dispatchCsi(uint8_t final) {
+  if (_intermediate == '$' && final == 'p') {  // DECRQM - request mode
+    if (_privMarker == '?') {
+      reportPrivateMode(param(0, 0));
+    } else if (_privMarker == 0) {
+      // No ANSI modes are settable: report "not recognized"
+      _replies.printf("\033[%d;0$y", param(0, 0));
+    }
     return;
   }
-  if (byte == ';') {
-    if (_paramCount < MAX_PARAMS) _paramCount++;
+  if (_intermediate == '$' && _privMarker == 0) {
+    dispatchRect(final);
     return;
   }
-  // Intermediate bytes (0x20-0x2F: space ! " # $ % & ' ( ) * + , - . /)
-  // Collect but mark as having intermediates so we can ignore unsupported sequences
-  if (byte >= 0x20 && byte <= 0x2F) {
-    _hasIntermediate = true;
+  // No other supported sequence carries intermediates
+  if (_intermediate != 0) return;
+
+  if (_privMarker == '?') {
+    if (final == 'h' || final == 'l') {  // DECSET / DECRST
+      for (int i = 0; i < _paramCount; i++) setPrivateMode(_params[i], final == 'h');
+    }
     return;
   }
-  // Dispatch final byte (0x40-0x7E)
-  if (byte >= 0x40 && byte <= 0x7E) {
-    // Dispatch if no intermediates and no unrecognized prefix
-    // _questionMark sequences go through dispatchCsi which handles them
-    if (!_hasIntermediate && _csiPrefix == 0) {
-      dispatchCsi(byte);
+  if (_privMarker == '>') {
+    if (final == 'c') {         // DA2 - secondary device attributes
+      _replies.push("\033[>0;10;0c");
+    } else if (final == 'q') {  // XTVERSION
+      _replies.printf("\033P>|%s(%s)\033\\", TERM_NAME, TERM_VERSION);
     }
-    // Sequences with intermediates or prefixes (like ESC[>c) are
-    // silently consumed — the final byte ends the sequence cleanly
-    _state = State::Ground;
     return;
   }
-  // Unknown byte - abort sequence cleanly
-  _state = State::Ground;
-}
+  // Other private markers (ESC[=c, ...) are consumed silently
+  if (_privMarker != 0) return;
 
-void VtParser::dispatchCsi(uint8_t cmd) {
   int n = param(0, 1);
 
-  if (_questionMark) {
-    int mode = param(0, 0);
-    switch (cmd) {
-      case 'h':  // DECSET
-        switch (mode) {
-          case 25: _cursorVisible = true; break;    // DECTCEM show cursor
-          case 47:    // alt screen (simple)
-          case 1047:  // alt screen
-          case 1049:  // alt screen + save cursor
-            if (mode == 1049) _buf.saveCursor();
-            _buf.switchScreen(true);
-            break;
-        }
-        break;
-      case 'l':  // DECRST
-        switch (mode) {
-          case 25: _cursorVisible = false; break;   // DECTCEM hide cursor
-          case 47:
-          case 1047:
-          case 1049:
-            _buf.switchScreen(false);
-            if (mode == 1049) _buf.restoreCursor();
-            break;
-        }
-        break;
-    }
-    return;
-  }
-
-  switch (cmd) {
+  switch (final) {
     case 'A': _buf.moveCursorUp(n); break;       // CUU
     case 'B': _buf.moveCursorDown(n); break;      // CUD
     case 'C': _buf.moveCursorForward(n); break;   // CUF
@@ -245,29 +500,123 @@ void VtParser::dispatchCsi(uint8_t cmd) {
       break;
     case 'm': handleSgr(); break;            // SGR
     case 'r':  // DECSTBM - set scroll region
-      _buf.setScrollRegion(param(0, 1) - 1, param(1, TERM_ROWS) - 1);
+      _buf.setScrollRegion(param(0, 1) - 1, param(1, _buf.rows()) - 1);
       break;
     case 'n':  // DSR - device status report
-      if (param(0, 0) == 6) {
-        // Cursor position report - send response over serial
-        // ESC [ row ; col R (1-based)
-        char resp[20];
-        snprintf(resp, sizeof(resp), "\033[%d;%dR",
-                 _buf.cursorRow() + 1, _buf.cursorCol() + 1);
-        Serial.print(resp);
+      if (param(0, 0) == 5) {
+        _replies.push("\033[0n");  // status: OK
+      } else if (param(0, 0) == 6) {
+        // Cursor position report: ESC [ row ; col R (1-based)
+        _replies.printf("\033[%d;%dR", _buf.cursorRow() + 1, _buf.cursorCol() + 1);
       }
       break;
     case 's': _buf.saveCursor(); break;     // ANSI save cursor
     case 'u': _buf.restoreCursor(); break;  // ANSI restore cursor
     case 'X': _buf.eraseChars(n); break;    // ECH - erase characters
     case 'c':  // DA - device attributes
-      Serial.print("\033[?1;0c");  // VT100 with no options
+      _replies.push("\033[?64;22;28c");  // VT420, ANSI color, rectangular editing
       break;
+    case 'b': _buf.repeatChar(n); break;    // REP - repeat last character
+    case 't': reportWindow(param(0, 0)); break;  // XTWINOPS (reports only)
+  }
+}
+
+// Rectangular area operations (CSI ... $ final). Coordinates are 1-based
+// with the whole screen as default.
+void VtParser::dispatchRect(uint8_t final) {
+  switch (final) {
+    case 'x': {  // DECFRA - fill rectangular area: Pch; Pt; Pl; Pb; Pr
+      int ch = param(0, 0);
+      if (!((ch >= 0x20 && ch < 0x7F) || (ch >= 0xA0 && ch <= 0xFF))) return;
+      _buf.fillRect(param(1, 1) - 1, param(2, 1) - 1,
+                    param(3, _buf.rows()) - 1, param(4, _buf.cols()) - 1, ch);
+      break;
+    }
+    case 'z':  // DECERA - erase rectangular area: Pt; Pl; Pb; Pr
+    case '{':  // DECSERA - selective erase (no cell is protected)
+      _buf.eraseRect(param(0, 1) - 1, param(1, 1) - 1,
+                     param(2, _buf.rows()) - 1, param(3, _buf.cols()) - 1);
+      break;
+    case 'v':  // DECCRA - copy area: Pts; Pls; Pbs; Prs; Pps; Ptd; Pld; Ppd
+      _buf.copyRect(param(0, 1) - 1, param(1, 1) - 1,
+                    param(2, _buf.rows()) - 1, param(3, _buf.cols()) - 1,
+                    param(5, 1) - 1, param(6, 1) - 1);
+      break;
+  }
+}
+
+void VtParser::reportWindow(int op) {
+  switch (op) {
+    case 14:  // text area size in pixels
+      _replies.printf("\033[4;%d;%dt", _buf.rows() * _cellH, _buf.cols() * _cellW);
+      break;
+    case 16:  // cell size in pixels
+      _replies.printf("\033[6;%d;%dt", _cellH, _cellW);
+      break;
+    case 18:  // text area size in characters
+      _replies.printf("\033[8;%d;%dt", _buf.rows(), _buf.cols());
+      break;
+  }
+}
+
+void VtParser::resized(int cellW, int cellH) {
+  _cellW = cellW;
+  _cellH = cellH;
+  if (_reportResize) reportResize();
+}
+
+// Mode 2048 notification: CSI 48 ; rows ; cols ; height px ; width px t
+void VtParser::reportResize() {
+  _replies.printf("\033[48;%d;%d;%d;%dt", _buf.rows(), _buf.cols(),
+                  _buf.rows() * _cellH, _buf.cols() * _cellW);
+}
+
+void VtParser::hook(uint8_t final) {
+  _dcsFinal = final;
+  _dcsLen = 0;
+}
+
+void VtParser::put(uint8_t byte) {
+  if (_dcsLen < sizeof(_dcsData)) _dcsData[_dcsLen++] = byte;
+}
+
+void VtParser::unhook() {
+  // DECRQSS - request selection or setting: DCS $ q Pt ST
+  if (_dcsFinal == 'q' && _intermediate == '$' && _privMarker == 0) {
+    reportSetting();
+  }
+  _dcsFinal = 0;
+  clear();
+}
+
+void VtParser::reportSetting() {
+  if (_dcsLen == 1 && _dcsData[0] == 'm') {  // SGR
+    static constexpr struct { uint8_t attr; char code; } kCodes[] = {
+      {TermStyle::ATTR_BOLD, '1'},    {TermStyle::ATTR_DIM, '2'},
+      {TermStyle::ATTR_ITALIC, '3'},  {TermStyle::ATTR_UNDERLINE, '4'},
+      {TermStyle::ATTR_BLINK, '5'},   {TermStyle::ATTR_INVERSE, '7'},
+      {TermStyle::ATTR_HIDDEN, '8'},  {TermStyle::ATTR_STRIKE, '9'},
+    };
+    char sgr[20] = "0";
+    int len = 1;
+    uint8_t attrs = _buf.currentAttrs();
+    for (const auto& c : kCodes) {
+      if (attrs & c.attr) {
+        sgr[len++] = ';';
+        sgr[len++] = c.code;
+      }
+    }
+    sgr[len] = 0;
+    _replies.printf("\033P1$r%sm\033\\", sgr);
+  } else if (_dcsLen == 1 && _dcsData[0] == 'r') {  // DECSTBM
+    _replies.printf("\033P1$r%d;%dr\033\\", _buf.scrollTop() + 1, _buf.scrollBottom() + 1);
+  } else {
+    _replies.push("\033P0$r\033\\");
   }
 }
 
 // Standard ANSI color palette: approximate luminance (0-255) for colors 0-15
-static const uint8_t kAnsiLum[16] = {
+static constexpr uint8_t kAnsiLum[16] = {
     0,  // 0: black
    76,  // 1: red
   149,  // 2: green
@@ -310,6 +659,72 @@ static uint8_t lumRGB(int r, int g, int b) {
   return (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
 }
 
+// ---------------------------------------------------------------------------
+// SGR lookup table: one entry per code 0-107
+// ---------------------------------------------------------------------------
+
+namespace {
+
+enum SgrOp : uint8_t {
+  SGR_IGNORE,
+  SGR_RESET,
+  SGR_SET_ATTR,    // arg = attribute bits
+  SGR_CLEAR_ATTR,  // arg = attribute bits
+  SGR_FG,          // arg = foreground luminance
+  SGR_FG_BOLD,     // arg = foreground luminance, also bold (bright colors)
+  SGR_BG,          // arg = background luminance
+  SGR_EXT_FG,      // 38;5;N or 38;2;R;G;B
+  SGR_EXT_BG,      // 48;5;N or 48;2;R;G;B
+};
+
+struct SgrEntry {
+  uint8_t op;
+  uint8_t arg;
+};
+
+constexpr int kSgrCount = 108;
+
+struct SgrTable {
+  SgrEntry e[kSgrCount] = {};
+};
+
+constexpr SgrTable buildSgrTable() {
+  SgrTable st;
+  st.e[0]  = {SGR_RESET, 0};
+  st.e[1]  = {SGR_SET_ATTR, TermStyle::ATTR_BOLD};
+  st.e[2]  = {SGR_SET_ATTR, TermStyle::ATTR_DIM};
+  st.e[3]  = {SGR_SET_ATTR, TermStyle::ATTR_ITALIC};
+  st.e[4]  = {SGR_SET_ATTR, TermStyle::ATTR_UNDERLINE};
+  st.e[5]  = {SGR_SET_ATTR, TermStyle::ATTR_BLINK};
+  st.e[6]  = {SGR_SET_ATTR, TermStyle::ATTR_BLINK};  // rapid blink
+  st.e[7]  = {SGR_SET_ATTR, TermStyle::ATTR_INVERSE};
+  st.e[8]  = {SGR_SET_ATTR, TermStyle::ATTR_HIDDEN};
+  st.e[9]  = {SGR_SET_ATTR, TermStyle::ATTR_STRIKE};
+  st.e[21] = {SGR_SET_ATTR, TermStyle::ATTR_UNDERLINE};  // double underline
+  st.e[22] = {SGR_CLEAR_ATTR, TermStyle::ATTR_BOLD | TermStyle::ATTR_DIM};
+  st.e[23] = {SGR_CLEAR_ATTR, TermStyle::ATTR_ITALIC};
+  st.e[24] = {SGR_CLEAR_ATTR, TermStyle::ATTR_UNDERLINE};
+  st.e[25] = {SGR_CLEAR_ATTR, TermStyle::ATTR_BLINK};
+  st.e[27] = {SGR_CLEAR_ATTR, TermStyle::ATTR_INVERSE};
+  st.e[28] = {SGR_CLEAR_ATTR, TermStyle::ATTR_HIDDEN};
+  st.e[29] = {SGR_CLEAR_ATTR, TermStyle::ATTR_STRIKE};
+  st.e[38] = {SGR_EXT_FG, 0};
+  st.e[39] = {SGR_FG, 0};    // default fg (black)
+  st.e[48] = {SGR_EXT_BG, 0};
+  st.e[49] = {SGR_BG, 255};  // default bg (white)
+  for (int i = 0; i < 8; i++) {
+    st.e[30 + i]  = {SGR_FG, kAnsiLum[i]};          // basic foreground
+    st.e[40 + i]  = {SGR_BG, kAnsiLum[i]};          // basic background
+    st.e[90 + i]  = {SGR_FG_BOLD, kAnsiLum[8 + i]};  // bright fg, shown bold
+    st.e[100 + i] = {SGR_BG, kAnsiLum[8 + i]};      // bright background
+  }
+  return st;
+}
+
+constexpr SgrTable kSgr = buildSgrTable();
+
+}  // namespace
+
 void VtParser::handleSgr() {
   if (_paramCount == 0) {
     _buf.resetAttrs();
@@ -318,80 +733,54 @@ void VtParser::handleSgr() {
 
   for (int i = 0; i < _paramCount; i++) {
     int p = _params[i];
-    switch (p) {
-      case 0:  _buf.resetAttrs(); break;
-      case 1:  _buf.setAttr(TermCell::ATTR_BOLD); break;
-      case 2:  _buf.clearAttr(TermCell::ATTR_BOLD); break;  // dim
-      case 4:  _buf.setAttr(TermCell::ATTR_UNDERLINE); break;
-      case 7:  _buf.setAttr(TermCell::ATTR_INVERSE); break;
-      case 22: _buf.clearAttr(TermCell::ATTR_BOLD); break;
-      case 24: _buf.clearAttr(TermCell::ATTR_UNDERLINE); break;
-      case 27: _buf.clearAttr(TermCell::ATTR_INVERSE); break;
-
-      // Basic foreground colors (dark) - no attribute change
-      case 30: case 31: case 32: case 33:
-      case 34: case 35: case 36: case 37:
+    if (p >= kSgrCount) continue;
+    const SgrEntry& e = kSgr.e[p];
+    switch (e.op) {
+      case SGR_RESET:      _buf.resetAttrs(); break;
+      case SGR_SET_ATTR:   _buf.setAttr(e.arg); break;
+      case SGR_CLEAR_ATTR: _buf.clearAttr(e.arg); break;
+      case SGR_FG:         _buf.setFgBright(e.arg); break;
+      case SGR_BG:         _buf.setBgBright(e.arg); break;
+      case SGR_FG_BOLD:
+        _buf.setFgBright(e.arg);
+        _buf.setAttr(TermStyle::ATTR_BOLD);
         break;
-      case 39: break;  // Default foreground
-
-      // Basic background colors - map to brightness
-      case 40: _buf.setBgBright(kAnsiLum[0]); break;   // black bg
-      case 41: _buf.setBgBright(kAnsiLum[1]); break;   // red bg
-      case 42: _buf.setBgBright(kAnsiLum[2]); break;   // green bg
-      case 43: _buf.setBgBright(kAnsiLum[3]); break;   // yellow bg
-      case 44: _buf.setBgBright(kAnsiLum[4]); break;   // blue bg
-      case 45: _buf.setBgBright(kAnsiLum[5]); break;   // magenta bg
-      case 46: _buf.setBgBright(kAnsiLum[6]); break;   // cyan bg
-      case 47: _buf.setBgBright(kAnsiLum[7]); break;   // white bg
-      case 49: _buf.setBgBright(255); break;            // default bg (white)
-
-      // Bright foreground - map to bold
-      case 90: case 91: case 92: case 93:
-      case 94: case 95: case 96: case 97:
-        _buf.setAttr(TermCell::ATTR_BOLD);
-        break;
-
-      // Bright background - map to brightness
-      case 100: _buf.setBgBright(kAnsiLum[8]); break;
-      case 101: _buf.setBgBright(kAnsiLum[9]); break;
-      case 102: _buf.setBgBright(kAnsiLum[10]); break;
-      case 103: _buf.setBgBright(kAnsiLum[11]); break;
-      case 104: _buf.setBgBright(kAnsiLum[12]); break;
-      case 105: _buf.setBgBright(kAnsiLum[13]); break;
-      case 106: _buf.setBgBright(kAnsiLum[14]); break;
-      case 107: _buf.setBgBright(kAnsiLum[15]); break;
 
       // Extended foreground color: 38;5;N or 38;2;R;G;B
-      case 38:
+      case SGR_EXT_FG:
         if (i + 1 < _paramCount && _params[i + 1] == 5) {
           // 256-color: 38;5;N
           if (i + 2 < _paramCount) {
-            int n = _params[i + 2];
-            if (n >= 8 && n < 16) _buf.setAttr(TermCell::ATTR_BOLD);
+            int n = _params[i + 2] & 0xFF;
+            _buf.setFgBright(lum256(n));
+            if (n >= 8 && n < 16) _buf.setAttr(TermStyle::ATTR_BOLD);
           }
           i += 2;
         } else if (i + 1 < _paramCount && _params[i + 1] == 2) {
           // RGB: 38;2;R;G;B
           if (i + 4 < _paramCount) {
-            uint8_t lum = lumRGB(_params[i + 2], _params[i + 3], _params[i + 4]);
-            if (lum > 150) _buf.setAttr(TermCell::ATTR_BOLD);
+            uint8_t lum = lumRGB(_params[i + 2] & 0xFF, _params[i + 3] & 0xFF,
+                                 _params[i + 4] & 0xFF);
+            _buf.setFgBright(lum);
+            if (lum > 150) _buf.setAttr(TermStyle::ATTR_BOLD);
           }
           i += 4;
         }
         break;
 
       // Extended background color: 48;5;N or 48;2;R;G;B
-      case 48:
+      case SGR_EXT_BG:
         if (i + 1 < _paramCount && _params[i + 1] == 5) {
           // 256-color: 48;5;N
           if (i + 2 < _paramCount) {
-            _buf.setBgBright(lum256(_params[i + 2]));
+            _buf.setBgBright(lum256(_params[i + 2] & 0xFF));
           }
           i += 2;
         } else if (i + 1 < _paramCount && _params[i + 1] == 2) {
           // RGB: 48;2;R;G;B
           if (i + 4 < _paramCount) {
-            _buf.setBgBright(lumRGB(_params[i + 2], _params[i + 3], _params[i + 4]));
+            _buf.setBgBright(lumRGB(_params[i + 2] & 0xFF, _params[i + 3] & 0xFF,
+                                    _params[i + 4] & 0xFF));
           }
           i += 4;
         }
@@ -401,3 +790,67 @@ void VtParser::handleSgr() {
     }
   }
 }
+
+void VtParser::save(StateWriter& w) const {
+  w.u8(static_cast<uint8_t>(_state));
+  w.u8(_paramCount);
+  for (int i = 0; i < _paramCount; i++) w.u16(_params[i]);
+  w.u8(_privMarker);
+  w.u8(_intermediate);
+  for (const Charsets* cs : {&_cs, &_savedCs}) {
+    w.write(cs->g, 4);
+    w.u8(cs->gl);
+  }
+  w.u8(_singleShift);
+  w.u8(_dcsFinal);
+  w.u8(_dcsLen);
+  w.write(_dcsData, _dcsLen);
+  w.u8(_cursorVisible | (_reportResize << 1));
+}
+
+bool VtParser::restore(StateReader& r) {
+  // Everything is read and checked before any of it is applied
+  uint8_t state = r.u8();
+  int paramCount = r.u8();
+  if (state >= static_cast<uint8_t>(State::Count) || paramCount > MAX_PARAMS) r.fail();
+  int params[MAX_PARAMS] = {};
+  for (int i = 0; i < paramCount && r.ok(); i++) params[i] = r.u16();
+  uint8_t privMarker = r.u8();
+  uint8_t intermediate = r.u8();
+  Charsets cs[2];
+  for (Charsets& c : cs) {
+    r.bytes(c.g, 4);
+    c.gl = r.u8();
+    for (uint8_t g : c.g) {
+      if (g >= CS_COUNT) r.fail();
+    }
+    if (c.gl > 3) r.fail();
+  }
+  uint8_t singleShift = r.u8();
+  if (singleShift == 1 || singleShift > 3) r.fail();
+  uint8_t dcsFinal = r.u8();
+  uint8_t dcsLen = r.u8();
+  if (dcsLen > sizeof(_dcsData)) r.fail();
+  uint8_t dcsData[sizeof(_dcsData)];
+  r.bytes(dcsData, r.ok() ? dcsLen : 0);
+  uint8_t modes = r.u8();
+  if (!r.ok()) return false;
+
+  _state = static_cast<State>(state);
+  _paramCount = paramCount;
+  memcpy(_params, params, sizeof(_params));
+  _privMarker = privMarker;
+  _intermediate = intermediate;
+  _cs = cs[0];
+  _savedCs = cs[1];
+  _singleShift = singleShift;
+  _dcsFinal = dcsFinal;
+  _dcsLen = dcsLen;
+  memcpy(_dcsData, dcsData, dcsLen);
+  _cursorVisible = modes & 1;
+  _reportResize = modes & 2;
+  _syncOutput = false;
+  _utf8.reset();
+  invokeCharset(_cs.gl);
+  return true;
+}
@@ -1,5 +1,8 @@
 #pragma once
+#include "ReplyQueue.h"
 #include "TermBuffer.h"
+#include "Utf8Decoder.h"
+#include <cstddef>
 #include <cstdint>
 
 class VtParser {
@@ -9,43 +12,117 @@ class VtParser {
   // Feed one byte from serial input
   void feed(uint8_t byte);
 
+  // Feed a block of serial input; runs of printable ASCII in Ground
+  // state are written to the buffer as spans instead of byte by byte
+  void feed(const uint8_t* data, size_t len);
+
   // Cursor visibility (controlled by DECTCEM ?25h/l)
   bool cursorVisible() const { return _cursorVisible; }
 
- private:
-  TermBuffer& _buf;
+  // Synchronized output (?2026h/l): host is mid-frame, hold off rendering
+  bool syncOutput() const { return _syncOutput; }
+  // Frames ended so far (?2026l, or RIS mid-frame). A change means a frame
+  // is complete and due to be drawn, even if the next one has begun since.
+  uint32_t syncFrames() const { return _syncFrames; }
+
+  // The grid or cell size changed (call after TermBuffer::resize). Window
+  // reports use the cell size; the host is told if it asked (mode 2048).
+  void resized(int cellW, int cellH);
 
-  enum class State {
+  // Persist the parser: modes, charsets and any sequence still being
+  // received. Synchronized output is not kept; the host is gone. On
+  // failure restore() leaves the parser as it was.
+  void save(StateWriter& w) const;
+  bool restore(StateReader& r);
+
+  // Replies to host queries, drained by the caller as TX room allows
+  ReplyQueue& replies() { return _replies; }
+
+  // Parser states of the DEC ANSI parser diagram (vt100.net/emu/dec_ansi_parser)
+  enum class State : uint8_t {
     Ground,
     Escape,
+    EscapeIntermediate,
     CsiEntry,
     CsiParam,
+    CsiIntermediate,
+    CsiIgnore,
+    DcsEntry,
+    DcsParam,
+    DcsIntermediate,
+    DcsPassthrough,
+    DcsIgnore,
     OscString,
-    EscSwallow,  // consume one byte after ESC( ESC) ESC#
+    SosPmApcString,
+    Count,
   };
 
+ private:
+  TermBuffer& _buf;
+  ReplyQueue _replies;
+
   State _state = State::Ground;
 
   static constexpr int MAX_PARAMS = 16;
+  static constexpr int MAX_PARAM_VALUE = 9999;
+  static constexpr uint8_t INTERMEDIATE_OVERFLOW = 0xFF;
   int _params[MAX_PARAMS] = {};
   int _paramCount = 0;
-  bool _questionMark = false;   // for DEC private modes (ESC [ ?)
-  bool _hasIntermediate = false; // CSI sequence has intermediate bytes (0x20-0x2F)
-  char _csiPrefix = 0;          // CSI parameter prefix: '>', '=', '<', etc.
-
-  void handleGround(uint8_t byte);
-  void handleEscape(uint8_t byte);
-  void handleCsiEntry(uint8_t byte);
-  void handleCsiParam(uint8_t byte);
-  void dispatchCsi(uint8_t cmd);
+  uint8_t _privMarker = 0;    // CSI private marker: '?', '>', '=', '<'
+  uint8_t _intermediate = 0;  // intermediate byte (0x20-0x2F), OVERFLOW if more than one
+
+  // Character sets: designations for G0-G3, the set invoked into GL
+  // (SI/SO/LS2/LS3) and a pending single shift (SS2/SS3)
+  struct Charsets {
+    uint8_t g[4] = {};
+    uint8_t gl = 0;
+  };
+  Charsets _cs;
+  Charsets _savedCs;
+  uint8_t _singleShift = 0;           // 2 or 3 while SS2/SS3 is pending
+  const uint16_t* _glMap = nullptr;   // translation for GL, nullptr = ASCII
+
+  // DCS string being received (only short control strings are kept)
+  uint8_t _dcsFinal = 0;
+  uint8_t _dcsData[8];
+  uint8_t _dcsLen = 0;
+
+  // Transition actions
+  void print(uint8_t byte);
+  void putCodepoint(uint32_t cp);
+  void flushUtf8();
+  void execute(uint8_t byte);
+  void clear();
+  void collect(uint8_t byte);
+  void paramByte(uint8_t byte);
+  void dispatchEsc(uint8_t final);
+  void dispatchCsi(uint8_t final);
+  void dispatchRect(uint8_t final);
+  void hook(uint8_t final);
+  void put(uint8_t byte);
+  void unhook();
+
+  void designateCharset(int g, uint8_t final);
+  void invokeCharset(int g);
+  uint16_t translate(uint8_t c);
+  void saveCursor();
+  void restoreCursor();
+
+  void setPrivateMode(int mode, bool on);
+  void endSyncFrame();
+  void reportPrivateMode(int mode);
+  void reportWindow(int op);
+  void reportResize();
+  void reportSetting();
   void handleSgr();
 
   int param(int idx, int def = 0) const;
-  void resetParams();
 
   bool _cursorVisible = true;
+  bool _syncOutput = false;
+  uint32_t _syncFrames = 0;
+  bool _reportResize = false;  // mode 2048
+  int _cellW = 0, _cellH = 0;  // pixels, from resized()
 
-  // UTF-8 decoder state
-  uint32_t _utf8Cp = 0;
-  int _utf8Remaining = 0;
+  Utf8Decoder _utf8;
 };
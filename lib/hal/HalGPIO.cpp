@@ -12,6 +12,7 @@ void HalGPIO::begin() {
 void HalGPIO::update() { inputMgr.update(); }
 
 bool HalGPIO::wasPressed(uint8_t btn) const { return inputMgr.wasPressed(btn); }
+bool HalGPIO::wasReleased(uint8_t btn) const { return inputMgr.wasReleased(btn); }
 bool HalGPIO::isPressed(uint8_t btn) const { return inputMgr.isPressed(btn); }
 unsigned long HalGPIO::getHeldTime() const { return inputMgr.getHeldTime(); }
 
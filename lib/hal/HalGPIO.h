@@ -24,6 +24,7 @@ class HalGPIO {
   void update();
 
   bool wasPressed(uint8_t btn) const;
+  bool wasReleased(uint8_t btn) const;
   bool isPressed(uint8_t btn) const;
   unsigned long getHeldTime() const;
 
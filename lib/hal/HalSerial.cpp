@@ -0,0 +1,66 @@
+#include "HalSerial.h"
+#include "HalGPIO.h"
+
+static HalSerial* instance = nullptr;
+
+void HalSerial::begin() {
+  instance = this;
+  Serial.setRxBufferSize(1024);
+  Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT,
+                 [](void*, esp_event_base_t, int32_t, void*) { instance->receive(Serial); });
+  Serial.begin(TERM_BAUD);  // USB CDC - baud rate ignored, always 12Mbps
+#if TERM_UART
+  // Interrupt-driven UART driver; its buffer only has to cover the gap
+  // until the callback runs
+  Serial0.setRxBufferSize(1024);
+  Serial0.onReceive([] { instance->receive(Serial0); });
+  Serial0.begin(TERM_BAUD, SERIAL_8N1, UART0_RXD, -1);
+#endif
+}
+
+// Runs in the transport's event task, so with TERM_UART two of these can
+// race; each packet goes into the ring whole under _pushLock. Everything
+// the driver holds is taken, not just what the event reported: events can
+// be dropped when they come faster than the task runs. XOFF is repeated
+// for each packet over the mark, in case an XON crossed it on the way out.
+void HalSerial::receive(Stream& in) {
+  uint8_t buf[64];
+  int avail;
+  while ((avail = in.available()) > 0) {
+    size_t n = in.read(buf, (size_t)avail < sizeof(buf) ? avail : sizeof(buf));
+    if (n == 0) break;
+    portENTER_CRITICAL(&_pushLock);
+    size_t pushed = _ring.push(buf, n);
+    portEXIT_CRITICAL(&_pushLock);
+    _overruns += n - pushed;
+  }
+  if (_ring.size() >= RX_XOFF_AT) {
+    _paused = true;
+    sendControl(XOFF);
+  }
+  TaskHandle_t reader = _reader.load();
+  if (reader) xTaskNotifyGive(reader);
+}
+
+// Send XON/XOFF without waiting for room in the USB TX FIFO, which would
+// stall the event task. Returns false if it did not fit.
+bool HalSerial::sendControl(uint8_t c) {
+  return Serial.availableForWrite() > 0 && Serial.write(c) == 1;
+}
+
+size_t HalSerial::read(uint8_t* data, size_t len, uint32_t waitMs) {
+  _reader = xTaskGetCurrentTaskHandle();
+  if (!_ring.size()) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+  size_t n = _ring.pop(data, len);
+  // Paused until the XON gets out; tried again on the next read
+  if (_paused && _ring.size() <= RX_XON_AT && sendControl(XON)) _paused = false;
+  return n;
+}
+
+int HalSerial::availableForWrite() {
+  return Serial.availableForWrite();
+}
+
+size_t HalSerial::write(const uint8_t* data, size_t len) {
+  return Serial.write(data, len);
+}
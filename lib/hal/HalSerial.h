@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "RxRing.h"
+
+// The link to the host: USB CDC and, with TERM_UART, the UART0 RX pin at
+// TERM_BAUD alongside it. Each transport's receive callback moves input
+// into one ring as it arrives, however busy the reader is. Once
+// RX_XOFF_AT bytes wait the host is sent XOFF, and XON when the reader
+// has drained them to RX_XON_AT. The UART's TX pin drives the panel, so
+// keys, replies and flow control only go out over USB.
+class HalSerial {
+ public:
+  void begin();
+
+  // Take up to len received bytes, waiting up to waitMs for the first.
+  // One reader task only.
+  size_t read(uint8_t* data, size_t len, uint32_t waitMs);
+
+  int availableForWrite();
+  size_t write(const uint8_t* data, size_t len);
+
+  // Input dropped because the ring was full
+  size_t overruns() const { return _overruns.load(); }
+
+ private:
+  static constexpr uint8_t XON = 0x11;
+  static constexpr uint8_t XOFF = 0x13;
+
+  RxRing _ring;
+  portMUX_TYPE _pushLock = portMUX_INITIALIZER_UNLOCKED;  // the ring takes one producer at a time
+  std::atomic<TaskHandle_t> _reader{nullptr};
+  std::atomic<bool> _paused{false};  // XOFF sent, XON not yet
+  std::atomic<size_t> _overruns{0};
+
+  void receive(Stream& in);
+  bool sendControl(uint8_t c);
+};
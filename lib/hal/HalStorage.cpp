@@ -0,0 +1,21 @@
+#include "HalStorage.h"
+
+bool HalStorage::begin() {
+  part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS,
+                                  "spiffs");
+  return part != nullptr;
+}
+
+size_t HalStorage::size() const { return part ? part->size : 0; }
+
+bool HalStorage::erase(size_t offset, size_t len) {
+  return part && esp_partition_erase_range(part, offset, len) == ESP_OK;
+}
+
+bool HalStorage::write(size_t offset, const void* data, size_t len) {
+  return part && esp_partition_write(part, offset, data, len) == ESP_OK;
+}
+
+bool HalStorage::read(size_t offset, void* data, size_t len) const {
+  return part && esp_partition_read(part, offset, data, len) == ESP_OK;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+// Raw access to the spare "spiffs" data partition (see partitions.csv).
+// No filesystem: callers own the layout. Erase works in whole sectors.
+class HalStorage {
+  const esp_partition_t* part = nullptr;
+
+ public:
+  static constexpr size_t SECTOR_SIZE = 4096;
+
+  bool begin();
+  size_t size() const;
+
+  bool erase(size_t offset, size_t len);
+  bool write(size_t offset, const void* data, size_t len);
+  bool read(size_t offset, void* data, size_t len) const;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "term_config.h"
+
+// Serial input waiting for the parser. One producer at a time (a
+// transport's receive callback; HalSerial serializes several) and one
+// consumer (the ingest task) share it without a lock: each index is
+// written by one side only, and stored after the bytes it covers, so the
+// other side never sees a byte before it is there.
+class RxRing {
+ public:
+  static constexpr size_t CAPACITY = RX_RING_BYTES;
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "RX_RING_BYTES must be a power of two");
+
+  // Producer: append up to len bytes; returns how many fit
+  size_t push(const uint8_t* data, size_t len) {
+    size_t head = _head.load(std::memory_order_relaxed);
+    size_t room = CAPACITY - (head - _tail.load(std::memory_order_acquire));
+    if (len > room) len = room;
+    size_t at = head & (CAPACITY - 1);
+    size_t first = len < CAPACITY - at ? len : CAPACITY - at;
+    memcpy(&_buf[at], data, first);
+    memcpy(_buf, data + first, len - first);
+    _head.store(head + len, std::memory_order_release);
+    return len;
+  }
+
+  // Consumer: take up to len bytes; returns how many
+  size_t pop(uint8_t* out, size_t len) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    size_t avail = _head.load(std::memory_order_acquire) - tail;
+    if (len > avail) len = avail;
+    size_t at = tail & (CAPACITY - 1);
+    size_t first = len < CAPACITY - at ? len : CAPACITY - at;
+    memcpy(out, &_buf[at], first);
+    memcpy(out + first, _buf, len - first);
+    _tail.store(tail + len, std::memory_order_release);
+    return len;
+  }
+
+  size_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+ private:
+  uint8_t _buf[CAPACITY];
+  std::atomic<size_t> _head{0};  // write position (free-running)
+  std::atomic<size_t> _tail{0};  // read position (free-running)
+};
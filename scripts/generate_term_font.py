@@ -14,6 +14,15 @@ Usage:
 
     # Custom font
     python3 generate_term_font.py --font /path/to/Font.ttf --width 10 --height 20
+
+    # Dense 8x16 cell at a forced size (line metrics overhang the cell;
+    # ASCII ink still fits)
+    python3 generate_term_font.py --width 8 --height 16 --pt-size 13 \
+        --ext-ranges 00A0-00FF,2010-2027,2190-2199
+
+Each cell size gets its own headers and namespaces (TermFont10x20 and
+TermFontExt10x20, TermFont8x16 and TermFontExt8x16, ...);
+lib/TermFont/TermFont.cpp lists the fonts built in.
 """
 
 import argparse
@@ -49,8 +58,14 @@ def find_system_mono_font():
     return None
 
 
-def load_font_fitting_cell(font_path, cell_w, cell_h):
+def load_font_fitting_cell(font_path, cell_w, cell_h, forced_pt=None):
     """Load font and find the largest pt size that fits the cell."""
+    if forced_pt:
+        try:
+            return ImageFont.truetype(font_path, forced_pt), forced_pt
+        except Exception as e:
+            print(f"Error loading font: {e}")
+            return None, None
     pt_size = max(1, cell_h)
     while pt_size > 0:
         try:
@@ -111,14 +126,15 @@ def is_glyph_blank(bitmap):
     return all(b == 0 for b in bitmap)
 
 
-def generate_font(font_path, cell_w, cell_h, output_path):
-    font, pt_size = load_font_fitting_cell(font_path, cell_w, cell_h)
+def generate_font(font_path, cell_w, cell_h, output_path, forced_pt=None):
+    font, pt_size = load_font_fitting_cell(font_path, cell_w, cell_h, forced_pt)
     if font is None:
         print("Error: Could not fit font into cell")
         return False
 
     ascent, descent = font.getmetrics()
     baseline = cell_h - descent
+    namespace = f"TermFont{cell_w}x{cell_h}"
 
     bytes_per_row = (cell_w + 7) // 8
     bytes_per_glyph = bytes_per_row * cell_h
@@ -149,7 +165,7 @@ def generate_font(font_path, cell_w, cell_h, output_path):
 #include <cstdint>
 #include <pgmspace.h>
 
-namespace TermFont {{
+namespace {namespace} {{
 
 static constexpr uint8_t FONT_W = {cell_w};
 static constexpr uint8_t FONT_H = {cell_h};
@@ -179,7 +195,7 @@ inline const uint8_t* getGlyph(uint8_t c) {{
     return &glyphs[(c - FIRST_CHAR) * BYTES_PER_GLYPH];
 }}
 
-}} // namespace TermFont
+}} // namespace {namespace}
 """)
 
     print(f"Output: {output_path}")
@@ -200,118 +216,146 @@ def parse_ranges(ranges_str):
     return ranges
 
 
-def generate_extended_font(font_path, cell_w, cell_h, ranges_str, output_path):
+def generate_extended_font(font_path, cell_w, cell_h, ranges_str, output_path,
+                           forced_pt=None):
     """Generate extended Unicode glyph header with pre-rendered glyphs from font."""
-    font, pt_size = load_font_fitting_cell(font_path, cell_w, cell_h)
+    font, pt_size = load_font_fitting_cell(font_path, cell_w, cell_h, forced_pt)
     if font is None:
         print("Error: Could not fit font into cell")
         return False
 
     ascent, descent = font.getmetrics()
     baseline = cell_h - descent
-    bytes_per_row = (cell_w + 7) // 8
-    bytes_per_glyph = bytes_per_row * cell_h
-
     ranges = parse_ranges(ranges_str)
 
-    total_glyphs = sum(end - start + 1 for start, end in ranges)
-    total_bytes = total_glyphs * bytes_per_glyph
-
     print(f"Extended Unicode font: {Path(font_path).name}, PT {pt_size}")
-    print(f"  Ranges: {len(ranges)}")
+    bitmaps = {}
     for start, end in ranges:
-        count = end - start + 1
-        print(f"    U+{start:04X}-U+{end:04X}: {count} glyphs ({count * bytes_per_glyph} bytes)")
-    print(f"  Total: {total_glyphs} glyphs, {total_bytes} bytes")
+        rendered = 0
+        blank = 0
+        for cp in range(start, end + 1):
+            bitmap = render_char(font, chr(cp), cell_w, cell_h, baseline, ascent)
+            if is_glyph_blank(bitmap) and cp > 0x20:
+                blank += 1
+            else:
+                rendered += 1
+            bitmaps[cp] = bitmap
+        print(f"    U+{start:04X}-U+{end:04X}: {rendered} rendered, {blank} blank")
 
     with open(output_path, 'w') as f:
-        f.write(f"""/**
+        write_extended_header(f, Path(font_path).name, pt_size, cell_w, cell_h,
+                              ranges, bitmaps)
+    print(f"Output: {output_path}")
+    return True
+
+
+def write_extended_header(f, font_name, pt_size, cell_w, cell_h, ranges, bitmaps):
+    """Write the extended glyphs and their two-level page table.
+
+    Glyphs are stored in codepoint order in one array. pageIndex maps the
+    high byte of a codepoint to a page (NO_PAGE if none); each page maps
+    the low byte to a glyph index (NO_GLYPH if none), so a lookup is two
+    table reads regardless of how many ranges there are.
+    """
+    bytes_per_glyph = ((cell_w + 7) // 8) * cell_h
+    namespace = f"TermFontExt{cell_w}x{cell_h}"
+    cps = sorted({cp for start, end in ranges for cp in range(start, end + 1)})
+    if len(cps) >= 0xFFFF:
+        raise ValueError("too many extended glyphs")
+    index = {cp: i for i, cp in enumerate(cps)}
+    page_ids = sorted({cp >> 8 for cp in cps})
+    if len(page_ids) >= 0xFF:
+        raise ValueError("too many pages")
+    total_bytes = len(cps) * bytes_per_glyph
+    table_bytes = 256 + len(page_ids) * 512
+
+    print(f"  Total: {len(cps)} glyphs, {total_bytes} bytes; "
+          f"{len(page_ids)} pages, {table_bytes} bytes")
+
+    f.write(f"""/**
  * Auto-generated extended Unicode font glyphs
- * Source: {Path(font_path).name}, PT size: {pt_size}
+ * Source: {font_name}, PT size: {pt_size}
  * Cell: {cell_w}x{cell_h}
- * Total: {total_glyphs} glyphs, {total_bytes} bytes (PROGMEM)
+ * Total: {len(cps)} glyphs, {total_bytes} bytes + {table_bytes} bytes page table (PROGMEM)
  *
  * Ranges:
 """)
-        for start, end in ranges:
-            f.write(f" *   U+{start:04X}-U+{end:04X} ({end - start + 1} glyphs)\n")
-        f.write(f""" */
+    for start, end in ranges:
+        f.write(f" *   U+{start:04X}-U+{end:04X} ({end - start + 1} glyphs)\n")
+    f.write(f""" */
 #pragma once
 
 #include <cstdint>
 #include <pgmspace.h>
 
-namespace TermFontExt {{
+namespace {namespace} {{
 
+static constexpr uint8_t FONT_W = {cell_w};
+static constexpr uint8_t FONT_H = {cell_h};
 static constexpr uint8_t BYTES_PER_GLYPH = {bytes_per_glyph};
-""")
+static constexpr uint16_t GLYPH_COUNT = {len(cps)};
+static constexpr uint8_t PAGE_COUNT = {len(page_ids)};
+static constexpr uint8_t NO_PAGE = 0xFF;
+static constexpr uint16_t NO_GLYPH = 0xFFFF;
 
-        # Generate each range as a separate PROGMEM array
-        range_names = []
-        for start, end in ranges:
-            count = end - start + 1
-            name = f"u{start:04X}"
-            range_names.append((name, start, end))
-
-            f.write(f"""
-// U+{start:04X}-U+{end:04X} ({count} glyphs, {count * bytes_per_glyph} bytes)
-static constexpr uint16_t {name}_START = 0x{start:04X};
-static constexpr uint16_t {name}_END = 0x{end:04X};
-static const uint8_t {name}[{count * bytes_per_glyph}] PROGMEM = {{
+// Glyph bitmaps in codepoint order
+static const uint8_t glyphs[{total_bytes}] PROGMEM = {{
 """)
-
-            rendered = 0
-            blank = 0
-            for cp in range(start, end + 1):
-                char = chr(cp)
-                bitmap = render_char(font, char, cell_w, cell_h, baseline, ascent)
-
-                if is_glyph_blank(bitmap) and cp > 0x20:
-                    blank += 1
-                else:
-                    rendered += 1
-
-                # Comment with character info
-                try:
-                    char_repr = char if (cp >= 0x20 and cp < 0x7F) else char
-                except Exception:
-                    char_repr = '?'
-                f.write(f"    // U+{cp:04X} '{char_repr}'\n    ")
-                for j, b in enumerate(bitmap):
-                    f.write(f"0x{b:02X},")
-                    if (j + 1) % 16 == 0 and j < len(bitmap) - 1:
-                        f.write("\n    ")
-                f.write("\n")
-
-            f.write("};\n")
-            print(f"    {name}: {rendered} rendered, {blank} blank")
-
-        # Generate lookup function
-        f.write("""
+    for cp in cps:
+        f.write(f"    // U+{cp:04X} '{chr(cp)}'\n    ")
+        bitmap = bitmaps[cp]
+        for j, b in enumerate(bitmap):
+            f.write(f"0x{b:02X},")
+            if (j + 1) % 16 == 0 and j < len(bitmap) - 1:
+                f.write("\n    ")
+        f.write("\n")
+    f.write("};\n")
+
+    f.write("""
+// Page of each codepoint high byte
+static const uint8_t pageIndex[256] PROGMEM = {
+""")
+    entries = [page_ids.index(hi) if hi in page_ids else 0xFF for hi in range(256)]
+    for row in range(0, 256, 16):
+        f.write("    " + ",".join(f"0x{v:02X}" for v in entries[row:row + 16]) + ",\n")
+    f.write("};\n")
+
+    f.write("""
+// Glyph index of each codepoint low byte, per page
+static const uint16_t pages[PAGE_COUNT][256] PROGMEM = {
+""")
+    for hi in page_ids:
+        f.write(f"    {{  // U+{hi:02X}xx\n")
+        entries = [index.get((hi << 8) | lo, 0xFFFF) for lo in range(256)]
+        for row in range(0, 256, 16):
+            f.write("        " + ",".join(f"0x{v:04X}" for v in entries[row:row + 16]) + ",\n")
+        f.write("    },\n")
+    f.write("};\n")
+
+    f.write(f"""
 /**
  * Look up a Unicode codepoint in the extended font tables.
  * Returns pointer to PROGMEM glyph data, or nullptr if not found.
  */
-inline const uint8_t* lookup(uint16_t cp) {
-""")
-        for name, start, end in range_names:
-            f.write(f"    if (cp >= 0x{start:04X} && cp <= 0x{end:04X})\n")
-            f.write(f"        return &{name}[(cp - 0x{start:04X}) * BYTES_PER_GLYPH];\n")
-        f.write("""    return nullptr;
-}
+inline const uint8_t* lookup(uint16_t cp) {{
+    uint8_t page = pgm_read_byte(&pageIndex[cp >> 8]);
+    if (page == NO_PAGE) return nullptr;
+    uint16_t glyph = pgm_read_word(&pages[page][cp & 0xFF]);
+    if (glyph == NO_GLYPH) return nullptr;
+    return &glyphs[glyph * BYTES_PER_GLYPH];
+}}
 
-} // namespace TermFontExt
+}} // namespace {namespace}
 """)
 
-    print(f"Output: {output_path}")
-    return True
-
 
 def main():
     parser = argparse.ArgumentParser(description='Generate terminal bitmap font header')
     parser.add_argument('--font', type=str, help='Path to monospace TTF/OTF font')
     parser.add_argument('--width', type=int, default=10, help='Cell width in pixels (default: 10)')
     parser.add_argument('--height', type=int, default=20, help='Cell height in pixels (default: 20)')
+    parser.add_argument('--pt-size', type=int,
+                        help='Render at this point size instead of the largest that fits the cell')
     parser.add_argument('--output', type=str, help='Output header path (ASCII font)')
     parser.add_argument('--ext-ranges', type=str,
                         help='Extended Unicode ranges to render, e.g. "00A0-00FF,2010-2027,2190-2199"')
@@ -341,7 +385,7 @@ def main():
 
     output_path.parent.mkdir(parents=True, exist_ok=True)
 
-    if not generate_font(font_path, args.width, args.height, str(output_path)):
+    if not generate_font(font_path, args.width, args.height, str(output_path), args.pt_size):
         print("ASCII font generation failed!")
         sys.exit(1)
 
@@ -350,12 +394,14 @@ def main():
         if args.ext_output:
             ext_output_path = Path(args.ext_output)
         else:
-            ext_output_path = project_root / 'lib' / 'TermFont' / 'term_font_ext.h'
+            ext_output_path = (project_root / 'lib' / 'TermFont' /
+                               f'term_font_ext_{args.width}x{args.height}.h')
 
         ext_output_path.parent.mkdir(parents=True, exist_ok=True)
 
         if not generate_extended_font(font_path, args.width, args.height,
-                                       args.ext_ranges, str(ext_output_path)):
+                                       args.ext_ranges, str(ext_output_path),
+                                       args.pt_size):
             print("Extended font generation failed!")
             sys.exit(1)
 
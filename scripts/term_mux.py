@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Host side of X4Term's virtual consoles: run one program per session on
+its own pseudo-terminal and carry them all over the one serial link.
+
+Usage:
+    # Shell and monitor on sessions 0 and 1
+    python3 term_mux.py /dev/cu.usbmodem2101 bash htop
+
+On the device, Power + Left/Right switches the session shown.
+
+Framing, the same in both directions:
+
+    DLE '0'..'9'   following bytes belong to that session
+    DLE DLE        a literal DLE
+
+The device has TERM_SESSIONS sessions (2 by default, --sessions if the
+firmware was built with another count) and drops input selected for any
+other, so there can be at most that many commands. Each pseudo-terminal
+follows the device's grid: resize reports (CSI ?2048h) are turned on in
+every session and consumed here, so programs that ask for them
+themselves will not see them.
+"""
+
+import argparse
+import fcntl
+import os
+import pty
+import re
+import select
+import struct
+import sys
+import termios
+
+try:
+    import serial
+except ImportError:
+    print("Error: pyserial not installed. Run: pip install pyserial")
+    sys.exit(1)
+
+
+DLE = 0x10
+RESIZE = re.compile(rb'\x1b\[48;(\d+);(\d+);(\d+);(\d+)t')
+# Held back for the next read; a lone ESC is not, it is the Back key
+RESIZE_PREFIX = re.compile(rb'\x1b\[4(8(;[\d;]*)?)?$')
+
+
+def frame(session, data):
+    """Frame one session's bytes for the device."""
+    return bytes([DLE, ord('0') + session]) + data.replace(b'\x10', b'\x10\x10')
+
+
+class Demux:
+    """Split the device's output into (session, bytes) runs."""
+
+    def __init__(self):
+        self.session = 0
+        self.escape = False  # DLE seen, selector pending
+
+    def feed(self, data):
+        runs = []
+        run = bytearray()
+        for b in data:
+            if self.escape:
+                self.escape = False
+                if 0x30 <= b <= 0x39:
+                    if run:
+                        runs.append((self.session, bytes(run)))
+                        run = bytearray()
+                    self.session = b - 0x30
+                    continue
+                run.append(DLE)
+                if b != DLE:
+                    run.append(b)
+                continue
+            if b == DLE:
+                self.escape = True
+            else:
+                run.append(b)
+        if run:
+            runs.append((self.session, bytes(run)))
+        return runs
+
+
+class Session:
+    def __init__(self, index, command):
+        self.index = index
+        self.pending = b''  # possible start of a resize report
+        self.pid, self.fd = pty.fork()
+        if self.pid == 0:
+            os.environ['TERM'] = 'xterm-256color'
+            os.execvp('/bin/sh', ['/bin/sh', '-c', command])
+
+    def to_program(self, data):
+        """Input from the device: apply and strip resize reports."""
+        data = self.pending + data
+        self.pending = b''
+        for m in RESIZE.finditer(data):
+            rows, cols, height, width = (int(v) for v in m.groups())
+            fcntl.ioctl(self.fd, termios.TIOCSWINSZ,
+                        struct.pack('HHHH', rows, cols, width, height))
+        data = RESIZE.sub(b'', data)
+        tail = RESIZE_PREFIX.search(data)
+        if tail:
+            self.pending = data[tail.start():]
+            data = data[:tail.start()]
+        if data and self.fd is not None:
+            os.write(self.fd, data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Multiplex programs onto X4Term sessions')
+    parser.add_argument('port', help='Serial port of the device')
+    parser.add_argument('commands', nargs='+', help='One command per session')
+    parser.add_argument('--sessions', type=int, default=2, choices=range(1, 11),
+                        metavar='N', help="The device's TERM_SESSIONS (default 2)")
+    args = parser.parse_args()
+    if len(args.commands) > args.sessions:
+        parser.error(f'the device has {args.sessions} sessions, got {len(args.commands)} commands')
+
+    ser = serial.Serial(args.port, 115200, timeout=0)
+    # The device sends XOFF/XON as its input buffer fills and drains; with
+    # IXON the tty holds our writes meanwhile and keeps them out of reads
+    attrs = termios.tcgetattr(ser.fileno())
+    attrs[0] |= termios.IXON
+    termios.tcsetattr(ser.fileno(), termios.TCSANOW, attrs)
+    sessions = [Session(i, cmd) for i, cmd in enumerate(args.commands)]
+    for s in sessions:
+        ser.write(frame(s.index, b'\x1b[?2048h'))  # also switches the device to framing
+
+    demux = Demux()
+    by_fd = {s.fd: s for s in sessions}
+    while by_fd:
+        ready, _, _ = select.select([ser.fileno()] + list(by_fd), [], [])
+        for fd in ready:
+            if fd == ser.fileno():
+                for index, data in demux.feed(ser.read(ser.in_waiting or 1)):
+                    if index < len(sessions):
+                        sessions[index].to_program(data)
+                continue
+            s = by_fd[fd]
+            try:
+                data = os.read(fd, 4096)
+            except OSError:
+                data = b''
+            if not data:
+                ser.write(frame(s.index, b'\r\n[exited]\r\n'))
+                del by_fd[fd]
+                os.close(fd)
+                s.fd = None
+                continue
+            ser.write(frame(s.index, data))
+
+
+if __name__ == '__main__':
+    main()
@@ -1,99 +1,370 @@
 #include <Arduino.h>
 #include "term_config.h"
 #include "HalGPIO.h"
-#include "TermBuffer.h"
-#include "VtParser.h"
+#include "HalSerial.h"
+#include "HalStorage.h"
+#include "TermSession.h"
+#include "TermMux.h"
 #include "TermRenderer.h"
+#include "TermSnapshot.h"
 #include <EInkDisplay.h>
+#include <atomic>
 
 // Hardware
 static EInkDisplay display(EPD_SCLK, EPD_MOSI, EPD_CS, EPD_DC, EPD_RST, EPD_BUSY);
 static HalGPIO gpio;
+static HalStorage storage;
+static HalSerial host;
 
-// Terminal
-static TermBuffer termBuf;
-static VtParser parser(termBuf);
-static TermRenderer renderer(display, termBuf);
+// Terminal: virtual consoles sharing the serial link; only the
+// foreground one is rendered, the others keep parsing
+static TermSession sessions[TERM_SESSIONS];  // 10x20 landscape; setup() applies the layout
+static uint8_t fgSession = 0;
+static TermMux mux(TERM_SESSIONS);
+static TermRenderer renderer(display, sessions[0].buf);
+static TermSnapshot snapshot(storage);
+
+static TermSession& fg() { return sessions[fgSession]; }
+
+static_assert(sizeof(sessions) + sizeof(TermCell) * TERM_MAX_CELLS /* scrollback view */ +
+                  sizeof(renderer) + sizeof(host) + DISPLAY_W / 8 * DISPLAY_H <= STATIC_RAM_BUDGET,
+              "static RAM over budget: fewer sessions, less scrollback or no back buffer");
+
+// Tasks. A refresh blocks on the panel's BUSY line for hundreds of ms,
+// so it runs in a task of its own, and serial input is parsed in another
+// as it arrives; loop() handles the buttons, sends replies and draws.
+// The sessions are shared under termLock, taken per chunk of input, per
+// button action and per draw but never across a refresh. A frame passes to the panel task
+// through panelBusy: set with the frame committed, cleared once shown.
+static SemaphoreHandle_t termLock;
+static TaskHandle_t panelTask;
+static std::atomic<bool> panelBusy{false};
 
 // Refresh rate limiting
 static unsigned long lastRefreshMs = 0;
 
-// Send escape sequence for button press
+// Last serial input, for ghosting cleanup once the host goes quiet
+static std::atomic<unsigned long> lastRxMs{0};
+
+// Synchronized output (DECSET 2026): time the current hold started, and
+// the foreground parser's count of ended frames when last drawn
+static bool syncHeld = false;
+static unsigned long syncStartMs = 0;
+static uint32_t syncFramesDrawn = 0;
+
+// Send escape sequence for button press to the foreground session
 static void sendKey(const char* seq) {
-  Serial.print(seq);
+  uint8_t out[16];
+  size_t len;
+  mux.encode(fgSession, (const uint8_t*)seq, strlen(seq), out, sizeof(out), len);
+  host.write(out, len);
 }
 
-static void handleButtons() {
-  if (gpio.wasPressed(HalGPIO::BTN_UP))      sendKey("\033[A");
-  if (gpio.wasPressed(HalGPIO::BTN_DOWN))    sendKey("\033[B");
-  if (gpio.wasPressed(HalGPIO::BTN_RIGHT))   sendKey("\033[C");
-  if (gpio.wasPressed(HalGPIO::BTN_LEFT))    sendKey("\033[D");
-  if (gpio.wasPressed(HalGPIO::BTN_CONFIRM)) sendKey("\r");
-  if (gpio.wasPressed(HalGPIO::BTN_BACK))    sendKey("\033");
+// Send queued replies to host queries without blocking on USB TX
+static void flushReplies() {
+  for (uint8_t s = 0; s < TERM_SESSIONS; s++) {
+    ReplyQueue& q = sessions[s].parser.replies();
+    const uint8_t* data;
+    size_t n;
+    while ((n = q.peek(&data)) > 0) {
+      uint8_t out[64];
+      int room = host.availableForWrite();
+      if (room < 4) return;
+      size_t len;
+      size_t used = mux.encode(s, data, n, out, (size_t)room < sizeof(out) ? room : sizeof(out), len);
+      host.write(out, len);  // within the reported room: written whole
+      q.consume(used);
+    }
+  }
+}
 
-  // Confirm + Back combo = force full refresh
-  if (gpio.isPressed(HalGPIO::BTN_CONFIRM) && gpio.isPressed(HalGPIO::BTN_BACK)) {
-    renderer.renderFull();
+// Wait for the panel task to show the frame in flight
+static void waitPanel() {
+  while (panelBusy.load()) vTaskDelay(1);
+}
+
+// Drawing goes to the back buffer at any time; without one, only while
+// the panel's framebuffer is not being shown
+static void waitToDraw() {
+  if (!RENDER_BACK_BUFFER) waitPanel();
+}
+
+// Hand what has been drawn to the panel task if it is free
+static void commitFrame() {
+  if (panelBusy.load() || !renderer.commit()) return;
+  lastRefreshMs = millis();
+  panelBusy.store(true);
+  xTaskNotifyGive(panelTask);
+}
+
+static void panelLoop(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    renderer.present();
+    panelBusy.store(false);
   }
+}
 
-  // Long press power = deep sleep
-  if (gpio.isPressed(HalGPIO::BTN_POWER) && gpio.getHeldTime() > 1500) {
+// Parse serial input as it arrives, also while the panel refreshes. A
+// flood never leaves the ring empty, so after each chunk the CPU is handed
+// to loop() and the panel task, which run at the same priority.
+static void ingestLoop(void*) {
+  static uint8_t rxBuf[512];
+  for (;;) {
+    size_t n = host.read(rxBuf, sizeof(rxBuf), 100);
+    if (n == 0) continue;
+    lastRxMs.store(millis());
+    xSemaphoreTake(termLock, portMAX_DELAY);
+    mux.feed(rxBuf, n, [](uint8_t s, const uint8_t* data, size_t len) {
+      sessions[s].parser.feed(data, len);
+    });
+    flushReplies();
+    xSemaphoreGive(termLock);
+    taskYIELD();
+  }
+}
+
+// Draw the foreground session's damage now rather than after the rate
+// limit; it is shown as soon as the panel is free
+static void drawNow() {
+  waitToDraw();
+  renderer.setCursorVisible(fg().parser.cursorVisible() && fg().buf.viewOffset() == 0);
+  renderer.drawDirty();
+}
+
+// Move the local scrollback view and show it right away
+static void scrollView(int lines) {
+  if (!fg().buf.scrollView(lines)) return;
+  drawNow();
+}
+
+// Scrollback view: buttons page through history locally, nothing is sent
+static void handleViewButtons() {
+  int page = fg().buf.rows();
+  if (gpio.wasPressed(HalGPIO::BTN_UP))    scrollView(page / 2);
+  if (gpio.wasPressed(HalGPIO::BTN_DOWN))  scrollView(-page / 2);
+  if (gpio.wasPressed(HalGPIO::BTN_LEFT))  scrollView(page);
+  if (gpio.wasPressed(HalGPIO::BTN_RIGHT)) scrollView(-page);
+  if (gpio.wasPressed(HalGPIO::BTN_BACK) || gpio.wasPressed(HalGPIO::BTN_CONFIRM)) {
+    scrollView(-fg().buf.viewOffset());
+  }
+}
+
+// Regrid every session to the renderer's layout. Resizing borrows the
+// cells of the shared scrollback view, so any open view is closed first.
+static void resizeSessions() {
+  for (TermSession& s : sessions) s.buf.scrollView(-s.buf.viewOffset());
+  for (TermSession& s : sessions) {
+    s.buf.resize(renderer.cols(), renderer.rows());
+    s.parser.resized(renderer.cellWidth(), renderer.cellHeight());
+  }
+}
+
+// Font/orientation change: regrid and reflow, tell the host, redraw
+static void applyLayout(uint8_t font, bool portrait) {
+  renderer.setLayout(font, portrait);
+  resizeSessions();
+  renderer.setCursorVisible(fg().parser.cursorVisible());
+  waitToDraw();
+  renderer.drawFull();
+}
+
+// Bring another session to the front. The panel is diffed against it, so
+// lines the two screens share are not redrawn.
+static void switchSession(int s) {
+  fg().buf.scrollView(-fg().buf.viewOffset());
+  fgSession = s;
+  syncFramesDrawn = fg().parser.syncFrames();
+  renderer.setBuffer(fg().buf);
+  fg().buf.markAllDirty();
+  drawNow();
+}
+
+// Pick up the sessions saved before the last deep sleep. The panel still
+// shows the foreground one, so it is only redrawn into the framebuffer.
+static bool resume() {
+  uint8_t font;
+  bool portrait;
+  if (!snapshot.probe(font, portrait)) {
+    snapshot.invalidate();
+    return false;
+  }
+  renderer.setLayout(font, portrait);
+  resizeSessions();
+  bool ok = snapshot.restore(sessions, TERM_SESSIONS, fgSession);
+  snapshot.invalidate();
+  if (!ok) ESP.restart();  // half-restored: start over from a cold boot
+
+  renderer.setBuffer(fg().buf);
+  renderer.setCursorVisible(fg().parser.cursorVisible());
+  renderer.renderFull(true);
+  lastRefreshMs = millis();
+  return true;
+}
+
+// Save the sessions and sleep with it left on the panel. Called with
+// termLock held, so nothing is parsed meanwhile.
+static void saveAndSleep() {
+  scrollView(-fg().buf.viewOffset());
+  drawNow();
+  waitPanel();
+  if (renderer.commit()) renderer.present();
+  if (!snapshot.save(renderer.font(), renderer.portrait(), sessions, TERM_SESSIONS, fgSession)) {
     display.clearScreen(0xFF);
     display.displayBuffer(EInkDisplay::FULL_REFRESH, true);
-    display.deepSleep();
-    gpio.startDeepSleep();
   }
+  display.deepSleep();
+  gpio.startDeepSleep();
 }
 
-void setup() {
-  Serial.setRxBufferSize(4096);  // Prevent overflow during display refresh
-  Serial.begin(TERM_BAUD);       // USB CDC - baud rate ignored, always 12Mbps
+static void handleButtons() {
+  // Power + Up = rotate, Power + Down = next font size, Power + Left/Right
+  // = previous/next session. Buttons pressed while Power is held are not
+  // sent to the host.
+  static unsigned long powerDownMs = 0;
+  static bool powerChord = false;
+  if (gpio.wasPressed(HalGPIO::BTN_POWER)) {
+    powerDownMs = millis();
+    powerChord = false;
+  }
+  if (gpio.isPressed(HalGPIO::BTN_POWER)) {
+    if (gpio.wasPressed(HalGPIO::BTN_UP)) {
+      applyLayout(renderer.font(), !renderer.portrait());
+      powerChord = true;
+    }
+    if (gpio.wasPressed(HalGPIO::BTN_DOWN)) {
+      applyLayout((renderer.font() + 1) % TermFont::FONT_COUNT, renderer.portrait());
+      powerChord = true;
+    }
+    if (gpio.wasPressed(HalGPIO::BTN_LEFT)) {
+      switchSession((fgSession + TERM_SESSIONS - 1) % TERM_SESSIONS);
+      powerChord = true;
+    }
+    if (gpio.wasPressed(HalGPIO::BTN_RIGHT)) {
+      switchSession((fgSession + 1) % TERM_SESSIONS);
+      powerChord = true;
+    }
+  }
+
+  // Short press power = enter/leave scrollback view
+  if (gpio.wasReleased(HalGPIO::BTN_POWER) && !powerChord &&
+      millis() - powerDownMs < 1500) {
+    scrollView(fg().buf.viewOffset() ? -fg().buf.viewOffset() : fg().buf.rows() / 2);
+  }
+
+  if (fg().buf.viewOffset() > 0) {
+    handleViewButtons();
+  } else if (!gpio.isPressed(HalGPIO::BTN_POWER)) {
+    if (gpio.wasPressed(HalGPIO::BTN_UP))      sendKey("\033[A");
+    if (gpio.wasPressed(HalGPIO::BTN_DOWN))    sendKey("\033[B");
+    if (gpio.wasPressed(HalGPIO::BTN_RIGHT))   sendKey("\033[C");
+    if (gpio.wasPressed(HalGPIO::BTN_LEFT))    sendKey("\033[D");
+    if (gpio.wasPressed(HalGPIO::BTN_CONFIRM)) sendKey("\r");
+    if (gpio.wasPressed(HalGPIO::BTN_BACK))    sendKey("\033");
 
+    // Confirm + Back combo = force full refresh
+    if (gpio.isPressed(HalGPIO::BTN_CONFIRM) && gpio.isPressed(HalGPIO::BTN_BACK)) {
+      waitToDraw();
+      renderer.drawFull();
+    }
+  }
+
+  // Long press power = deep sleep
+  if (gpio.isPressed(HalGPIO::BTN_POWER) && !powerChord && gpio.getHeldTime() > 1500) {
+    saveAndSleep();
+  }
+}
+
+void setup() {
   gpio.begin();
+  host.begin();  // after gpio, which claims UART0_RXD as a plain input
   display.begin();
 
-  // Clear display to white
-  display.clearScreen(0xFF);
-  display.displayBuffer(EInkDisplay::FULL_REFRESH, false);
-
-  // Draw initial terminal screen (blank with cursor)
-  renderer.renderFull();
-
-  // Print banner to terminal buffer
-  const char* lines[] = {
-    "Welcome to RobCo Industries (TM) Termlink",
-    "Initializing...",
-  };
-  for (int i = 0; i < 2; i++) {
-    for (const char* p = lines[i]; *p; p++) {
-      parser.feed(*p);
+  // Waking from sleep: the panel already shows the saved session.
+  // Otherwise clear the panel and draw the banner in one full refresh.
+  if (!storage.begin() || !resume()) {
+    const char* lines[] = {
+      "Welcome to RobCo Industries (TM) Termlink",
+      "Initializing...",
+    };
+    for (int i = 0; i < 2; i++) {
+      fg().parser.feed((const uint8_t*)lines[i], strlen(lines[i]));
+      fg().parser.feed('\r');
+      fg().parser.feed('\n');
     }
-    parser.feed('\r');
-    parser.feed('\n');
+    applyLayout(TermFont::FONT_10X20, false);
   }
 
-  renderer.renderDirty();
+  // All at loop()'s priority: input, drawing and the panel take turns
+  termLock = xSemaphoreCreateMutex();
+  xTaskCreate(panelLoop, "panel", 4096, nullptr, 1, &panelTask);
+  xTaskCreate(ingestLoop, "ingest", 4096, nullptr, 1, nullptr);
 }
 
 void loop() {
-  // 1. Drain serial input
-  while (Serial.available()) {
-    uint8_t byte = Serial.read();
-    parser.feed(byte);
-  }
-
-  // 2. Handle button input
+  // 1. Handle button input
   gpio.update();
+  xSemaphoreTake(termLock, portMAX_DELAY);
   handleButtons();
 
-  // 3. Render if dirty and enough time has passed
-  if (termBuf.dirtyRows() != 0) {
-    unsigned long now = millis();
-    if (now - lastRefreshMs >= MIN_REFRESH_INTERVAL_MS) {
-      renderer.setCursorVisible(parser.cursorVisible());
-      renderer.renderDirty();
-      lastRefreshMs = now;
+  // Replies queued outside the ingest task (the size report after a
+  // layout change) or left over when USB TX was full go out from here, so
+  // they don't wait for the host's next byte
+  flushReplies();
+
+  // 2. Draw if dirty and enough time has passed. While the host is
+  // mid-frame (synchronized output) damage accumulates and goes out as one
+  // refresh when the frame ends. The ingest task may have ended a frame
+  // and begun the next within one chunk, so the end is taken from the
+  // parser's frame count rather than the mode; the timeout only flushes a
+  // frame that never ends, once per SYNC_OUTPUT_TIMEOUT_MS. The scrollback
+  // view is only redrawn by the buttons that move it; output keeps
+  // accumulating underneath. With a back buffer this goes on while the
+  // panel shows the previous frame.
+  unsigned long rxMs = lastRxMs.load();
+  unsigned long now = millis();
+  uint32_t frames = fg().parser.syncFrames();
+  bool frameEnded = frames != syncFramesDrawn;
+  bool hold = false;
+  if (fg().parser.syncOutput()) {
+    if (!syncHeld) {
+      syncHeld = true;
+      syncStartMs = now;
+    }
+    // An ended frame is drawn; the hold restarts with the one in progress
+    if (!frameEnded && now - syncStartMs < SYNC_OUTPUT_TIMEOUT_MS) {
+      hold = true;
+    } else {
+      syncStartMs = now;
+    }
+  } else {
+    syncHeld = false;
+  }
+
+  if (!hold && fg().buf.viewOffset() == 0 && (RENDER_BACK_BUFFER || !panelBusy.load())) {
+    renderer.setCursorVisible(fg().parser.cursorVisible());
+    // The echo of a keystroke (or a lone cursor move) goes out as soon as
+    // the input pauses, and an ended frame at once; anything else is
+    // batched by the rate limit
+    bool echo = now - rxMs >= ECHO_QUIET_MS && renderer.echoOnly();
+    if (echo || frameEnded ||
+        (fg().buf.dirtyRows().any() && now - lastRefreshMs >= MIN_REFRESH_INTERVAL_MS)) {
+      renderer.drawDirty();
     }
+    syncFramesDrawn = frames;
+  }
+  xSemaphoreGive(termLock);
+
+  // 3. Hand the drawing to the panel task once it is free. Rows rewritten
+  // with the same content drew nothing, and don't hold off the next change.
+  commitFrame();
+
+  // 4. Once nothing has arrived or been drawn for a while, clear what
+  // ghosting the fast refreshes left with one full refresh
+  now = millis();
+  if (now - rxMs >= IDLE_CLEANUP_MS && now - lastRefreshMs >= IDLE_CLEANUP_MS &&
+      !panelBusy.load() && renderer.cleanup()) {
+    commitFrame();
   }
 
   // Small delay to batch input and reduce CPU
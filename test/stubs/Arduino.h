@@ -0,0 +1,5 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Host builds: the core's types come from the standard headers
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// Host stand-in for the SDK's panel driver: the framebuffer the renderer
+// draws into, and a count of the refreshes it asks for.
+class EInkDisplay {
+ public:
+  enum RefreshMode { FULL_REFRESH, HALF_REFRESH, FAST_REFRESH };
+  static constexpr uint16_t DISPLAY_WIDTH = 800;
+  static constexpr uint16_t DISPLAY_HEIGHT = 480;
+  static constexpr uint16_t DISPLAY_WIDTH_BYTES = DISPLAY_WIDTH / 8;
+  static constexpr uint32_t BUFFER_SIZE = DISPLAY_WIDTH_BYTES * DISPLAY_HEIGHT;
+
+  EInkDisplay() { clearScreen(); }
+
+  void clearScreen(uint8_t color = 0xFF) const { memset(_frame, color, BUFFER_SIZE); }
+  void displayBuffer(RefreshMode mode = FAST_REFRESH, bool = false) {
+    if (mode == FULL_REFRESH) fullRefreshes++;
+    else fastRefreshes++;
+  }
+  void displayWindow(uint16_t, uint16_t, uint16_t, uint16_t, bool = false) { windows++; }
+  uint8_t* getFrameBuffer() const { return _frame; }
+
+  int fullRefreshes = 0;
+  int fastRefreshes = 0;
+  int windows = 0;
+
+ private:
+  mutable uint8_t _frame[BUFFER_SIZE];
+};
@@ -0,0 +1,5 @@
+#pragma once
+
+// Host builds: HalStorage only keeps a pointer to the partition; the
+// test that needs storage defines HalStorage itself over memory
+typedef struct esp_partition_t esp_partition_t;
@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+
+// Host builds: flash data is ordinary memory
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
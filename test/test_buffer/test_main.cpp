@@ -0,0 +1,136 @@
+#include <unity.h>
+#include <string>
+#include "TermBuffer.h"
+
+// TermBuffer through its own interface: reflow on resize and the style
+// table behind the cells.
+
+static uint8_t historyMem[4096];
+static Scrollback history(historyMem, sizeof(historyMem));
+static TermBuffer buf(20, 5);
+
+// Type text: '\n' is CR LF
+static void write(const char* s) {
+  for (; *s; s++) {
+    if (*s == '\n') {
+      buf.carriageReturn();
+      buf.lineFeed();
+    } else {
+      buf.putChar(*s);
+    }
+  }
+}
+
+static std::string row(int r) {
+  std::string s;
+  for (int c = 0; c < buf.cols(); c++) s += char(buf.cellAt(r, c).codepoint);
+  while (!s.empty() && s.back() == ' ') s.pop_back();
+  return s;
+}
+
+// Lines joined by autowrap are rewrapped at the new width and the cursor
+// stays on the same character; narrowing pushes the top lines into the
+// scrollback, widening joins the rows again
+static void test_resize_reflows() {
+  write("abcdefghijklmnopqrstuvwxy\nshort");
+  TEST_ASSERT_EQUAL(2, buf.cursorRow());
+  TEST_ASSERT_EQUAL(5, buf.cursorCol());
+
+  buf.resize(10, 5);
+  TEST_ASSERT_EQUAL_STRING("abcdefghij", row(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("klmnopqrst", row(1).c_str());
+  TEST_ASSERT_EQUAL_STRING("uvwxy", row(2).c_str());
+  TEST_ASSERT_EQUAL_STRING("short", row(3).c_str());
+  TEST_ASSERT_EQUAL(3, buf.cursorRow());
+  TEST_ASSERT_EQUAL(5, buf.cursorCol());
+
+  buf.resize(8, 3);
+  TEST_ASSERT_EQUAL(2, history.lines());  // rows, as they were on screen
+  TEST_ASSERT_EQUAL_STRING("qrstuvwx", row(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("y", row(1).c_str());
+  TEST_ASSERT_EQUAL_STRING("short", row(2).c_str());
+  TEST_ASSERT_EQUAL(2, buf.cursorRow());
+  TEST_ASSERT_EQUAL(5, buf.cursorCol());
+
+  buf.resize(30, 3);
+  TEST_ASSERT_EQUAL_STRING("qrstuvwxy", row(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("short", row(1).c_str());
+  TEST_ASSERT_EQUAL(1, buf.cursorRow());
+  TEST_ASSERT_EQUAL(5, buf.cursorCol());
+
+  // The cursor past the end of a line, and on the alternate screen the
+  // main screen's saved cursor, are tracked the same way
+  write("      ");
+  buf.switchScreen(true);
+  buf.resize(4, 6);
+  buf.switchScreen(false);
+  TEST_ASSERT_EQUAL_STRING("shor", row(3).c_str());
+  TEST_ASSERT_EQUAL_STRING("t", row(4).c_str());
+  TEST_ASSERT_EQUAL(5, buf.cursorRow());
+  TEST_ASSERT_EQUAL(3, buf.cursorCol());
+}
+
+// The pen as a style: fg and bg from i, which gives 1024 distinct ones
+static TermStyle penFor(int i) {
+  TermStyle s;
+  s.fg = i & 0xFF;
+  s.bg = i >> 8;
+  return s;
+}
+
+static void setPen(const TermStyle& s) {
+  buf.setFgBright(s.fg);
+  buf.setBgBright(s.bg);
+}
+
+// Far more styles than the table holds can pass through, as long as few
+// are on screen at once: the sweep reclaims the rest, and never one a cell
+// on either screen still uses
+static void test_style_sweep() {
+  TermStyle kept = penFor(300);
+  setPen(kept);
+  write("k");
+  buf.switchScreen(true);
+  for (int i = 0; i < 1024; i++) {
+    setPen(penFor(i));
+    buf.setCursor(1, 0);
+    buf.putChar('x');
+    TEST_ASSERT_TRUE(buf.style(buf.cellAt(1, 0).style) == penFor(i));
+  }
+  buf.switchScreen(false);
+  TEST_ASSERT_TRUE(buf.style(buf.cellAt(0, 0).style) == kept);
+
+  // With every entry on screen, new styles fall back to the default until
+  // the screen is erased
+  buf.resize(40, 10);
+  buf.setCursor(0, 0);
+  for (int i = 0; i < 400; i++) {
+    setPen(penFor(i));
+    buf.putChar('x');
+  }
+  int r = 399 / 40, c = 399 % 40;
+  TEST_ASSERT_TRUE(buf.style(buf.cellAt(r, c).style) == TermStyle());
+  TEST_ASSERT_TRUE(buf.style(buf.cellAt(0, 0).style) == penFor(0));
+  buf.resetAttrs();
+  buf.eraseDisplay(2);
+  buf.setCursor(0, 0);
+  setPen(penFor(500));
+  buf.putChar('x');
+  TEST_ASSERT_TRUE(buf.style(buf.cellAt(0, 0).style) == penFor(500));
+}
+
+void setUp() {
+  buf.resize(20, 5);
+  buf.eraseDisplay(2);
+  buf.setCursor(0, 0);
+  history.clear();
+  buf.attachScrollback(&history);
+}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_resize_reflows);
+  RUN_TEST(test_style_sweep);
+  return UNITY_END();
+}
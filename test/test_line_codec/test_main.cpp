@@ -0,0 +1,154 @@
+#include <unity.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "LineCodec.h"
+#include "Scrollback.h"
+
+// Encoded lines decode to the cells they came from, alone and through the
+// scrollback ring as it evicts, saves and restores.
+
+static StyleTable styles;
+static uint8_t palette[64];  // style ids rows are drawn with
+
+struct MemoryWriter : StateWriter {
+  std::vector<uint8_t> data;
+  void write(const uint8_t* d, size_t n) override { data.insert(data.end(), d, d + n); }
+};
+
+struct MemoryReader : StateReader {
+  const std::vector<uint8_t>& data;
+  size_t pos = 0;
+  explicit MemoryReader(const std::vector<uint8_t>& d) : data(d) {}
+  bool read(uint8_t* d, size_t n) override {
+    if (pos + n > data.size()) return false;
+    memcpy(d, &data[pos], n);
+    pos += n;
+    return true;
+  }
+};
+
+static void makePalette() {
+  styles = StyleTable();
+  palette[0] = StyleTable::DEFAULT;
+  for (int i = 1; i < 64; i++) {
+    TermStyle st;
+    st.fg = rand() % 256;
+    st.bg = rand() % 256;
+    st.attrs = rand() % 256;
+    TEST_ASSERT_TRUE(styles.intern(st, palette[i]));
+  }
+}
+
+// Runs of styles and characters, rules, wide codepoints and trailing blanks
+static void randomRow(TermCell* row, int cols) {
+  static const uint16_t kChars[] = {'a', 'Z', ' ', '-', 0xE9, 0x3B1, 0x2500, 0x2588, 0x28FF, 0xFFFD};
+  for (int c = 0; c < cols; c++) row[c] = TermCell();
+  int used = rand() % (cols + 1);
+  for (int c = 0; c < used;) {
+    uint8_t id = rand() % 2 ? palette[rand() % 64] : StyleTable::DEFAULT;
+    uint16_t cp = kChars[rand() % 10];
+    for (int run = 1 + rand() % 12; run > 0 && c < used; run--, c++) {
+      row[c].style = id;
+      row[c].codepoint = rand() % 4 ? cp : kChars[rand() % 10];
+    }
+  }
+}
+
+static void checkLine(const TermCell* row, int cols, size_t len,
+                      const std::vector<uint8_t>& encoded) {
+  std::vector<TermCell> cells(cols);
+  std::vector<TermStyle> decoded(cols);
+  LineCodec::decode(len, [&](size_t i) { return encoded[i]; }, cols,
+                    [&](int col, uint16_t cp, const TermStyle& st) {
+                      cells[col].codepoint = cp;
+                      decoded[col] = st;
+                    });
+  for (int c = 0; c < cols; c++) {
+    TEST_ASSERT_EQUAL(row[c].codepoint, cells[c].codepoint);
+    TEST_ASSERT_TRUE(styles[row[c].style] == decoded[c]);
+  }
+}
+
+static void test_line_round_trip() {
+  srand(1);
+  makePalette();
+  TermCell row[TERM_MAX_COLS];
+  std::vector<uint8_t> encoded(LineCodec::MAX_BYTES);
+  for (int i = 0; i < 2000; i++) {
+    int cols = 1 + rand() % TERM_MAX_COLS;
+    randomRow(row, cols);
+    size_t len = LineCodec::encode(row, cols, styles, encoded.data());
+    TEST_ASSERT_LESS_OR_EQUAL(LineCodec::MAX_BYTES, len);
+    checkLine(row, cols, len, encoded);
+  }
+}
+
+// The worst case fits MAX_BYTES: every cell a new style and a 3-byte character
+static void test_line_worst_case_fits() {
+  styles = StyleTable();
+  TermCell row[TERM_MAX_COLS];
+  for (int c = 0; c < TERM_MAX_COLS; c++) {
+    TermStyle st;
+    st.fg = c;
+    st.attrs = c & 1;
+    TEST_ASSERT_TRUE(styles.intern(st, row[c].style));
+    row[c].codepoint = 0x2500 + c % 2;
+  }
+  std::vector<uint8_t> encoded(LineCodec::MAX_BYTES);
+  size_t len = LineCodec::encode(row, TERM_MAX_COLS, styles, encoded.data());
+  TEST_ASSERT_LESS_OR_EQUAL(LineCodec::MAX_BYTES, len);
+  checkLine(row, TERM_MAX_COLS, len, encoded);
+}
+
+// Reads back the newest lines after the ring has wrapped many times, and
+// again after a save and restore
+static void test_scrollback_round_trip() {
+  srand(2);
+  makePalette();
+  static uint8_t mem[4096], restoredMem[4096];
+  Scrollback history(mem, sizeof(mem));
+  const int cols = 80, pushed = 500;
+  static TermCell lines[pushed][cols];
+  for (int i = 0; i < pushed; i++) {
+    randomRow(lines[i], cols);
+    history.push(lines[i], cols, styles);
+  }
+  TEST_ASSERT_TRUE(history.lines() > 0 && history.lines() < pushed);
+  TEST_ASSERT_LESS_OR_EQUAL(sizeof(mem), history.bytesUsed());
+
+  MemoryWriter w;
+  history.save(w);
+  Scrollback restored(restoredMem, sizeof(restoredMem));
+  MemoryReader r(w.data);
+  TEST_ASSERT_TRUE(restored.restore(r));
+  TEST_ASSERT_EQUAL(history.lines(), restored.lines());
+
+  for (const Scrollback* sb : {&history, &restored}) {
+    for (int n = 1; n <= sb->lines(); n++) {
+      const TermCell* row = lines[pushed - n];
+      TermCell cells[cols];
+      TermStyle decoded[cols];
+      TEST_ASSERT_TRUE(sb->read(n, cols, [&](int col, uint16_t cp, const TermStyle& st) {
+        cells[col].codepoint = cp;
+        decoded[col] = st;
+      }));
+      for (int c = 0; c < cols; c++) {
+        TEST_ASSERT_EQUAL(row[c].codepoint, cells[c].codepoint);
+        TEST_ASSERT_TRUE(styles[row[c].style] == decoded[c]);
+      }
+    }
+    TEST_ASSERT_FALSE(sb->read(sb->lines() + 1, cols, [](int, uint16_t, const TermStyle&) {}));
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_line_round_trip);
+  RUN_TEST(test_line_worst_case_fits);
+  RUN_TEST(test_scrollback_round_trip);
+  return UNITY_END();
+}
@@ -0,0 +1,94 @@
+#include <unity.h>
+#include <cstdlib>
+#include <string>
+#include "TermMux.h"
+
+// Session framing: what one side encodes the other splits back into the
+// same per-session bytes, however the link cuts it up.
+
+static const uint8_t kSessions = 3;
+
+static void collect(TermMux& mux, const std::string& wire, std::string* out) {
+  mux.feed(reinterpret_cast<const uint8_t*>(wire.data()), wire.size(),
+           [&](uint8_t s, const uint8_t* data, size_t len) {
+             TEST_ASSERT_TRUE(s < kSessions);
+             out[s].append(reinterpret_cast<const char*>(data), len);
+           });
+}
+
+static void test_round_trip() {
+  srand(1);
+  for (int i = 0; i < 200; i++) {
+    TermMux tx(kSessions), rx(kSessions);
+    std::string sent[kSessions], wire;
+    collect(tx, "\x10" "0", sent);  // a host that selects makes the encoder frame
+
+    // Interleaved chunks of random bytes, DLE-heavy, in frames of random room
+    for (int chunk = rand() % 40; chunk > 0; chunk--) {
+      uint8_t s = rand() % kSessions;
+      std::string data;
+      for (int n = rand() % 32; n > 0; n--) data += char(rand() % 4 ? rand() % 256 : TermMux::DLE);
+      size_t done = 0;
+      while (done < data.size()) {
+        uint8_t out[64];
+        size_t room = 4 + rand() % 30, outLen;
+        done += tx.encode(s, reinterpret_cast<const uint8_t*>(data.data()) + done,
+                          data.size() - done, out, room, outLen);
+        TEST_ASSERT_TRUE(outLen <= room);
+        wire.append(reinterpret_cast<const char*>(out), outLen);
+      }
+      sent[s] += data;
+    }
+
+    // Fed in pieces split anywhere, a DLE and its selector included
+    std::string got[kSessions];
+    for (size_t at = 0; at < wire.size();) {
+      size_t n = 1 + rand() % 9;
+      collect(rx, wire.substr(at, n), got);
+      at += n;
+    }
+    for (int s = 0; s < kSessions; s++) TEST_ASSERT_TRUE(got[s] == sent[s]);
+  }
+}
+
+// A host that never selects is a plain terminal
+static void test_plain_host() {
+  TermMux mux(kSessions);
+  std::string got[kSessions];
+  std::string wire = "ls\r\n\x10x\x10";
+  collect(mux, wire, got);
+  TEST_ASSERT_FALSE(mux.active());
+  TEST_ASSERT_TRUE(got[0] == "ls\r\n\x10x");  // the trailing DLE waits for its selector
+
+  const uint8_t reply[] = {'o', 'k', TermMux::DLE};
+  uint8_t out[8];
+  size_t outLen;
+  TEST_ASSERT_EQUAL(3, mux.encode(1, reply, 3, out, sizeof(out), outLen));
+  TEST_ASSERT_EQUAL(3, outLen);
+  TEST_ASSERT_EQUAL_MEMORY(reply, out, 3);
+}
+
+// Input for a session the device does not have is dropped until the
+// host selects one it has
+static void test_unknown_session() {
+  TermMux mux(kSessions);
+  std::string got[kSessions];
+  collect(mux, std::string("\x10" "1a\x10" "9b\x10\x10" "c"), got);
+  collect(mux, std::string("d\x10"), got);
+  collect(mux, std::string("2e"), got);
+  TEST_ASSERT_TRUE(mux.active());
+  TEST_ASSERT_TRUE(got[0].empty());
+  TEST_ASSERT_TRUE(got[1] == "a");
+  TEST_ASSERT_TRUE(got[2] == "e");
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_plain_host);
+  RUN_TEST(test_unknown_session);
+  return UNITY_END();
+}
@@ -0,0 +1,192 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "TermFont.h"
+#include "VtParser.h"
+
+// The parser's effect on the grid and its replies to the host, driven
+// through the byte stream the way a host would.
+
+static TermBuffer buf(78, 24);
+static VtParser parser(buf);
+
+static void feed(const char* s) {
+  parser.feed(reinterpret_cast<const uint8_t*>(s), strlen(s));
+}
+
+static uint16_t at(int row, int col) { return buf.cellAt(row, col).codepoint; }
+
+// G0-G3 designation, the locking shifts into GL and the single shifts,
+// which apply to one character only
+static void test_charset_shifts() {
+  feed("\033)0q\016q\017q");  // G1 = graphics; SO, SI
+  TEST_ASSERT_EQUAL('q', at(0, 0));
+  TEST_ASSERT_EQUAL(0x2500, at(0, 1));
+  TEST_ASSERT_EQUAL('q', at(0, 2));
+
+  feed("\r\n\033*0\033+A\033Nqq\033O##");  // G2 = graphics, G3 = UK; SS2, SS3
+  TEST_ASSERT_EQUAL(0x2500, at(1, 0));
+  TEST_ASSERT_EQUAL('q', at(1, 1));
+  TEST_ASSERT_EQUAL(0x00A3, at(1, 2));
+  TEST_ASSERT_EQUAL('#', at(1, 3));
+
+  feed("\r\n\033nx\033o#\017x#");  // LS2, LS3, back to G0
+  TEST_ASSERT_EQUAL(0x2502, at(2, 0));
+  TEST_ASSERT_EQUAL(0x00A3, at(2, 1));
+  TEST_ASSERT_EQUAL('x', at(2, 2));
+  TEST_ASSERT_EQUAL('#', at(2, 3));
+
+  // A single shift inside a printable run covers its first character
+  feed("\r\n\033Nqrs");
+  TEST_ASSERT_EQUAL(0x2500, at(3, 0));
+  TEST_ASSERT_EQUAL('r', at(3, 1));
+
+  // Designating an unknown set keeps the current one; DECSC/DECRC save
+  // and restore the charsets with the cursor
+  feed("\r\n\033(0\033(Za\033(B\0337\033(0\0338a");
+  TEST_ASSERT_EQUAL(0x2592, at(4, 0));
+  TEST_ASSERT_EQUAL('a', at(4, 1));
+}
+
+// Every character DEC Special Graphics translates has a glyph of its own
+// in each face, not the '?' that stands in for a missing one
+static void test_dec_graphics_have_glyphs() {
+  for (int c = 0x5F; c <= 0x7E; c++) {
+    feed("\033[H\033(0");
+    parser.feed(c);
+    feed("\033(B");
+    uint16_t cp = buf.cellAt(0, 0).codepoint;
+    if (cp == c) continue;
+    for (int f = 0; f < TermFont::FONT_COUNT; f++) {
+      const TermFont::Face& face = TermFont::face(f);
+      uint32_t ink[TermFont::MAX_HEIGHT], missing[TermFont::MAX_HEIGHT];
+      face.render(cp, ink);
+      face.render('?', missing);
+      char message[48];
+      snprintf(message, sizeof message, "U+%04X in %s", cp, face.name);
+      TEST_ASSERT_TRUE_MESSAGE(memcmp(ink, missing, face.height * sizeof(ink[0])) != 0, message);
+    }
+  }
+}
+
+// The text of row cells [col, col + n), '.' standing for anything
+// beyond ASCII
+static std::string text(int row, int col, int n) {
+  std::string s;
+  for (int c = col; c < col + n; c++) s += at(row, c) < 0x80 ? char(at(row, c)) : '.';
+  return s;
+}
+
+// REP repeats the last character written, wrapping like typed text
+static void test_rep() {
+  feed("ab\033[3b");
+  TEST_ASSERT_EQUAL_STRING("abbbb ", text(0, 0, 6).c_str());
+  feed("\033[1;77Hxy\033[2b");
+  TEST_ASSERT_EQUAL_STRING("xy", text(0, 76, 2).c_str());
+  TEST_ASSERT_EQUAL_STRING("yy ", text(1, 0, 3).c_str());
+  feed("\033(0\033[3;1Hq\033[2b\033(B");  // the translated character
+  TEST_ASSERT_EQUAL(0x2500, at(2, 2));
+}
+
+// DECFRA, DECERA and DECCRA clip to the screen; a rectangle wholly off it,
+// or inverted, does nothing
+static void test_rect_clipping() {
+  feed("\033[42;23;75;30;90$x");  // '*' over rows 23-30, cols 75-90
+  TEST_ASSERT_EQUAL_STRING(" ****", text(22, 73, 5).c_str());
+  TEST_ASSERT_EQUAL_STRING(" ****", text(23, 73, 5).c_str());
+  TEST_ASSERT_EQUAL_STRING("    ", text(21, 74, 4).c_str());
+  feed("\033[42;30;1;40;10$x\033[42;5;5;4;4$x\033[31;1;1;2;2$x");  // off screen, inverted, a control
+  TEST_ASSERT_EQUAL_STRING("    ", text(0, 0, 4).c_str());
+  TEST_ASSERT_EQUAL_STRING("    ", text(4, 0, 4).c_str());
+
+  feed("\033[24;77;99;99$z");  // erase the corner that ran off the right
+  TEST_ASSERT_EQUAL_STRING(" **  ", text(23, 73, 5).c_str());
+
+  feed("\033[H0123456789\033[1;1;1;10;1;24;72;1$v");  // copy to the bottom right edge
+  TEST_ASSERT_EQUAL_STRING("0123456", text(23, 71, 7).c_str());
+  feed("\033[1;3;1;8;1;1;1;1$v");  // overlapping, to the left
+  TEST_ASSERT_EQUAL_STRING("2345676789", text(0, 0, 10).c_str());
+  feed("\033[1;1;1;10;1;1;99;1$v");  // destination off screen
+  TEST_ASSERT_EQUAL_STRING("2345676789", text(0, 0, 10).c_str());
+}
+
+// Everything the parser has queued for the host
+static std::string replies() {
+  std::string out;
+  ReplyQueue& q = parser.replies();
+  const uint8_t* data;
+  size_t n;
+  while ((n = q.peek(&data)) > 0) {
+    out.append(reinterpret_cast<const char*>(data), n);
+    q.consume(n);
+  }
+  return out;
+}
+
+// Synchronized output follows DECSET/DECRST 2026 and DECRQM reports it,
+// so a host can tell the mode is supported before relying on it
+static void test_sync_output_mode() {
+  feed("\033[?2026$p");
+  TEST_ASSERT_EQUAL_STRING("\033[?2026;2$y", replies().c_str());
+  feed("\033[?2026h");
+  TEST_ASSERT_TRUE(parser.syncOutput());
+  feed("\033[?2026$p\033[?9999$p\033[4$p");
+  TEST_ASSERT_EQUAL_STRING("\033[?2026;1$y\033[?9999;0$y\033[4;0$y", replies().c_str());
+  feed("\033[?2026l");
+  TEST_ASSERT_FALSE(parser.syncOutput());
+  feed("\033[?2026h\033c");  // RIS ends a frame too
+  TEST_ASSERT_FALSE(parser.syncOutput());
+}
+
+// A frame that ends and a next one that begins within one feed still
+// counts as ended, so the first is drawn rather than held with the second
+static void test_sync_frame_ended_in_one_feed() {
+  uint32_t frames = parser.syncFrames();
+  feed("\033[?2026hone\033[?2026l\033[?2026htwo");
+  TEST_ASSERT_TRUE(parser.syncOutput());
+  TEST_ASSERT_EQUAL(frames + 1, parser.syncFrames());
+  feed("\033[?2026l\033[?2026l\033[?2026h\033c");  // a second ?2026l ends nothing
+  TEST_ASSERT_EQUAL(frames + 3, parser.syncFrames());
+}
+
+// DECRQSS reports the SGR attributes and the scroll region, and refuses
+// anything else
+static void test_decrqss() {
+  feed("\033[1;4;7m\033P$qm\033\\");
+  TEST_ASSERT_EQUAL_STRING("\033P1$r0;1;4;7m\033\\", replies().c_str());
+  feed("\033[5;20r\033P$qr\033\\\033P$q\"p\033\\");
+  TEST_ASSERT_EQUAL_STRING("\033P1$r5;20r\033\\\033P0$r\033\\", replies().c_str());
+}
+
+// Replies the host is slow to take are kept whole: once the queue is
+// full, further ones are dropped rather than cut short
+static void test_replies_dropped_whole() {
+  for (int i = 0; i < 100; i++) feed("\033[6n");
+  std::string out = replies();
+  TEST_ASSERT_TRUE(out.size() <= ReplyQueue::CAPACITY);
+  TEST_ASSERT_EQUAL(0, out.size() % 6);
+  for (size_t i = 0; i < out.size(); i += 6) {
+    TEST_ASSERT_EQUAL_STRING("\033[1;1R", out.substr(i, 6).c_str());
+  }
+  TEST_ASSERT_TRUE(parser.replies().dropped() > 0);
+}
+
+void setUp() {
+  feed("\033c");
+  replies();
+}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_dec_graphics_have_glyphs);
+  RUN_TEST(test_charset_shifts);
+  RUN_TEST(test_rep);
+  RUN_TEST(test_rect_clipping);
+  RUN_TEST(test_sync_output_mode);
+  RUN_TEST(test_sync_frame_ended_in_one_feed);
+  RUN_TEST(test_decrqss);
+  RUN_TEST(test_replies_dropped_whole);
+  return UNITY_END();
+}
@@ -0,0 +1,173 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "TermRenderer.h"
+#include "VtParser.h"
+
+// The renderer against references that share none of its shortcuts: the
+// font bitmaps read directly, a redraw from nothing, and the framebuffer
+// of a fixed screen. Layouts are numbered font | portrait << 1.
+
+static EInkDisplay display;
+static TermBuffer buf(78, 24);
+static VtParser parser(buf);
+static TermRenderer renderer(display, buf);
+static TermRenderer scratch(display, buf);  // only ever draws the whole screen
+static uint8_t frame[EInkDisplay::BUFFER_SIZE];
+
+static void feed(const char* s) {
+  parser.feed(reinterpret_cast<const uint8_t*>(s), strlen(s));
+}
+
+static void useLayout(int layout) {
+  renderer.setLayout(layout & 1, layout >> 1);
+  scratch.setLayout(layout & 1, layout >> 1);
+  buf.resize(renderer.cols(), renderer.rows());
+  feed("\033[r\033[0m\033[2J\033[H\033[?25h");
+  renderer.setCursorVisible(true);
+  renderer.renderFull();
+}
+
+// Ink at a logical pixel; portrait has the top of the text along the
+// panel's right edge
+static bool inkAt(int x, int y) {
+  int fx = renderer.portrait() ? DISPLAY_W - 1 - y : x;
+  int fy = renderer.portrait() ? x : y;
+  return !(display.getFrameBuffer()[fy * (DISPLAY_W / 8) + fx / 8] & (0x80 >> (fx & 7)));
+}
+
+static uint32_t frameHash() {
+  uint32_t h = 2166136261u;  // FNV-1a
+  const uint8_t* fb = display.getFrameBuffer();
+  for (uint32_t i = 0; i < EInkDisplay::BUFFER_SIZE; i++) h = (h ^ fb[i]) * 16777619u;
+  return h;
+}
+
+// Plain text is the font's bitmap, pixel for pixel
+static void test_text_matches_font() {
+  for (int layout = 0; layout < 4; layout++) {
+    useLayout(layout);
+    feed("\033[?25l");
+    renderer.setCursorVisible(false);
+    for (int r = 0; r < buf.rows(); r++) {
+      char line[16 + TERM_MAX_COLS];
+      int n = snprintf(line, 16, "\033[%d;1H", r + 1);
+      for (int c = 0; c < buf.cols(); c++) line[n++] = 0x21 + (r * 7 + c) % 94;
+      line[n] = 0;
+      feed(line);
+    }
+    renderer.renderDirty();
+
+    const TermFont::Face& face = TermFont::face(renderer.font());
+    int w = renderer.cellWidth(), h = renderer.cellHeight();
+    int width = renderer.portrait() ? DISPLAY_H : DISPLAY_W;
+    int height = renderer.portrait() ? DISPLAY_W : DISPLAY_H;
+    int x0 = (width - renderer.cols() * w) / 2, y0 = (height - renderer.rows() * h) / 2;
+    int wrong = 0;
+    for (int r = 0; r < buf.rows(); r++) {
+      for (int c = 0; c < buf.cols(); c++) {
+        uint32_t ink[TermFont::MAX_HEIGHT];
+        face.render(buf.cellAt(r, c).codepoint, ink);
+        for (int y = 0; y < h; y++) {
+          for (int x = 0; x < w; x++) {
+            wrong += inkAt(x0 + c * w + x, y0 + r * h + y) != ((ink[y] >> (31 - x)) & 1);
+          }
+        }
+      }
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(0, wrong, "pixels differ from the font");
+  }
+}
+
+// Scrolls, IL/DL, ICH/DCH, erases and styled writes drawn incrementally
+// (moved framebuffer bands, skipped cells) leave the same pixels as
+// drawing the screen from nothing
+static void test_incremental_matches_full_redraw() {
+  srand(1);
+  for (int layout = 0; layout < 4; layout++) {
+    useLayout(layout);
+    int rows = renderer.rows(), cols = renderer.cols();
+    int differing = 0;
+    for (int step = 0; step < 1500; step++) {
+      for (int ops = rand() % 6; ops > 0; ops--) {
+        char s[64];
+        switch (rand() % 12) {
+          case 0: snprintf(s, sizeof s, "\033[%d;%dr", 1 + rand() % rows, 1 + rand() % rows); break;
+          case 1: snprintf(s, sizeof s, "\033[%dS", 1 + rand() % 3); break;
+          case 2: snprintf(s, sizeof s, "\033[%dT", 1 + rand() % 3); break;
+          case 3: snprintf(s, sizeof s, "\033[%dL", 1 + rand() % 3); break;
+          case 4: snprintf(s, sizeof s, "\033[%dM", 1 + rand() % 3); break;
+          case 5: snprintf(s, sizeof s, "\033[%d@", 1 + rand() % 5); break;
+          case 6: snprintf(s, sizeof s, "\033[%dP", 1 + rand() % 5); break;
+          case 7: snprintf(s, sizeof s, "\033[%d;%dH", 1 + rand() % rows, 1 + rand() % cols); break;
+          case 8:
+            snprintf(s, sizeof s, "\033[48;5;%d;%dmab%cd\342\224\200\033[0m", 232 + rand() % 24,
+                     rand() % 2 ? 1 : 4, 'A' + rand() % 26);
+            break;
+          case 9: snprintf(s, sizeof s, "line %d\r\n", rand()); break;
+          case 10: snprintf(s, sizeof s, "\033[?25%c", rand() % 2 ? 'h' : 'l'); break;
+          default: snprintf(s, sizeof s, "\033[%dX", 1 + rand() % 4); break;
+        }
+        feed(s);
+      }
+      renderer.setCursorVisible(parser.cursorVisible());
+      renderer.renderDirty();
+      memcpy(frame, display.getFrameBuffer(), sizeof(frame));
+      scratch.setCursorVisible(parser.cursorVisible());
+      scratch.renderFull();
+      differing += memcmp(frame, display.getFrameBuffer(), sizeof(frame)) != 0;
+      memcpy(display.getFrameBuffer(), frame, sizeof(frame));
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(0, differing, "incremental frames differ from a full redraw");
+  }
+}
+
+// A fixed screen of every kind of cell, its framebuffer hashed per
+// layout: any change to what is drawn shows up here. If drawing changes
+// on purpose, take the new hashes from the failure message.
+static void test_fixed_screen_unchanged() {
+  static const uint32_t kHashes[4] = {0xD7BBF648, 0x6A6120AA, 0x3473AE4A, 0x1925ABDB};
+  for (int layout = 0; layout < 4; layout++) {
+    useLayout(layout);
+    feed("\033[1mbold\033[0m \033[3mitalic\033[0m \033[4munder\033[0m \033[9mstrike\033[0m "
+         "\033[2mdim\033[0m \033[7mreverse\033[0m \033[8mhidden\033[0m\r\n"
+         "\033[38;5;255;48;5;236m light on dark \033[38;5;232;48;5;250m dark on light \033[0m\r\n"
+         "\342\224\214\342\224\200\342\224\220 \342\226\210\342\226\223\342\226\222\342\226\221 "
+         "\342\240\277 caf\303\251 \342\206\222 \342\200\224\r\n"
+         "\033(0lqqk\033(B ~!@#$%^&*()_+{}|:\"<>?");
+    renderer.renderFull();
+    char message[32];
+    snprintf(message, sizeof message, "layout %d", layout);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(kHashes[layout], frameHash(), message);
+  }
+}
+
+// Output that swings the whole panel back and forth builds up ghosting in
+// every band; it is cleaned a few bands at a time, never with a full
+// refresh while output goes on
+static void test_ghosting_cleaned_without_full_refresh() {
+  useLayout(0);
+  int full = display.fullRefreshes;
+  for (int i = 0; i < 8; i++) {
+    feed("\033[H");
+    for (int r = 0; r < buf.rows(); r++) {
+      for (int c = 0; c < buf.cols(); c++) feed(i & 1 ? " " : "\342\226\210");
+    }
+    renderer.renderDirty();
+  }
+  TEST_ASSERT_EQUAL(full, display.fullRefreshes);
+  TEST_ASSERT_TRUE(renderer.cleanup());
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_text_matches_font);
+  RUN_TEST(test_incremental_matches_full_redraw);
+  RUN_TEST(test_fixed_screen_unchanged);
+  RUN_TEST(test_ghosting_cleaned_without_full_refresh);
+  return UNITY_END();
+}
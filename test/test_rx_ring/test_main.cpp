@@ -0,0 +1,75 @@
+#include <unity.h>
+#include <cstdlib>
+#include <deque>
+#include <thread>
+#include "RxRing.h"
+
+// The input ring against a plain queue, and across two threads as the
+// receive callback and the ingest task use it.
+
+static RxRing ring;
+
+static void test_matches_queue() {
+  srand(1);
+  std::deque<uint8_t> model;
+  uint8_t next = 0;
+  for (int i = 0; i < 20000; i++) {
+    uint8_t data[3 * RxRing::CAPACITY / 4];
+    if (rand() % 2) {
+      size_t len = rand() % sizeof(data);
+      for (size_t k = 0; k < len; k++) data[k] = next + k;
+      size_t room = RxRing::CAPACITY - model.size();
+      size_t pushed = ring.push(data, len);
+      TEST_ASSERT_EQUAL(len < room ? len : room, pushed);
+      for (size_t k = 0; k < pushed; k++) model.push_back(data[k]);
+      next += pushed;
+    } else {
+      size_t len = rand() % sizeof(data);
+      size_t popped = ring.pop(data, len);
+      TEST_ASSERT_EQUAL(len < model.size() ? len : model.size(), popped);
+      for (size_t k = 0; k < popped; k++) {
+        TEST_ASSERT_EQUAL(model.front(), data[k]);
+        model.pop_front();
+      }
+    }
+    TEST_ASSERT_EQUAL(model.size(), ring.size());
+  }
+}
+
+// Every byte arrives once and in order while both ends run flat out
+static void test_two_threads() {
+  uint8_t drain[RxRing::CAPACITY];
+  while (ring.pop(drain, sizeof(drain))) {
+  }
+  const uint32_t total = 16u << 20;
+  std::thread producer([] {
+    uint32_t sent = 0;
+    uint8_t data[300];
+    while (sent < total) {
+      size_t len = 1 + (sent * 7919u) % sizeof(data);
+      if (len > total - sent) len = total - sent;
+      for (size_t k = 0; k < len; k++) data[k] = uint8_t((sent + k) * 31u);
+      sent += ring.push(data, len);
+    }
+  });
+  uint32_t received = 0, wrong = 0;
+  uint8_t data[500];
+  while (received < total) {
+    size_t n = ring.pop(data, 1 + received % sizeof(data));
+    for (size_t k = 0; k < n; k++) wrong += data[k] != uint8_t((received + k) * 31u);
+    received += n;
+  }
+  producer.join();
+  TEST_ASSERT_EQUAL(0, wrong);
+  TEST_ASSERT_EQUAL(0, ring.size());
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_queue);
+  RUN_TEST(test_two_threads);
+  return UNITY_END();
+}
@@ -0,0 +1,188 @@
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include "TermSnapshot.h"
+
+// Sessions saved to a snapshot and restored into fresh ones come back as
+// they were: screens, styles, cursor, scrollback and the parser mid-sequence.
+
+// The storage partition, as NOR flash: erase sets bits, writes clear them
+static uint8_t flash[64 * 1024];
+
+bool HalStorage::begin() { return true; }
+size_t HalStorage::size() const { return sizeof(flash); }
+
+bool HalStorage::erase(size_t offset, size_t len) {
+  if (offset % SECTOR_SIZE || len % SECTOR_SIZE || offset + len > sizeof(flash)) return false;
+  memset(&flash[offset], 0xFF, len);
+  return true;
+}
+
+bool HalStorage::write(size_t offset, const void* data, size_t len) {
+  if (offset + len > sizeof(flash)) return false;
+  const uint8_t* src = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; i++) flash[offset + i] &= src[i];
+  return true;
+}
+
+bool HalStorage::read(size_t offset, void* data, size_t len) const {
+  if (offset + len > sizeof(flash)) return false;
+  memcpy(data, &flash[offset], len);
+  return true;
+}
+
+static HalStorage storage;
+static TermSnapshot snapshot(storage);
+static TermSession saved[2];
+static TermSession restored[2];
+
+static void feed(TermSession& s, const char* text) {
+  s.parser.feed(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+// The visible rows: text, '.' standing for anything beyond ASCII, and
+// each change of style in brackets
+static std::string screen(const TermSession& s) {
+  std::string out;
+  TermStyle last;
+  for (int r = 0; r < s.buf.rows(); r++) {
+    for (int c = 0; c < s.buf.cols(); c++) {
+      const TermCell& cell = s.buf.cellAt(r, c);
+      const TermStyle& st = s.buf.style(cell.style);
+      if (st != last) {
+        out += '[' + std::to_string(st.fg) + ',' + std::to_string(st.bg) + ',' +
+               std::to_string(st.attrs) + ']';
+        last = st;
+      }
+      out += cell.codepoint < 0x80 ? char(cell.codepoint) : '.';
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+// The scrollback as shown scrolled all the way back
+static std::string history(TermSession& s) {
+  s.buf.scrollView(s.history.lines());
+  std::string out = screen(s);
+  s.buf.scrollView(-s.buf.viewOffset());
+  return out;
+}
+
+static std::string replies(TermSession& s) {
+  std::string out;
+  const uint8_t* data;
+  size_t n;
+  while ((n = s.parser.replies().peek(&data)) > 0) {
+    out.append(reinterpret_cast<const char*>(data), n);
+    s.parser.replies().consume(n);
+  }
+  return out;
+}
+
+static void test_round_trip() {
+  for (int i = 0; i < 40; i++) feed(saved[0], "\033[1;7mbold\033[0m plain \033[4mline\033[0m\r\n");
+  feed(saved[0], "\033[5;20r\033[?1049h\033)0\016qx\033[10;4H\033[3");  // alt screen, SO, mid-CSI
+  feed(saved[1], "\033[38;5;240mother\033[2;3H");
+  TEST_ASSERT_TRUE(snapshot.save(1, true, saved, 2, 1));
+
+  uint8_t font;
+  bool portrait;
+  uint8_t foreground;
+  TEST_ASSERT_TRUE(snapshot.probe(font, portrait));
+  TEST_ASSERT_EQUAL(1, font);
+  TEST_ASSERT_TRUE(portrait);
+  TEST_ASSERT_TRUE(snapshot.restore(restored, 2, foreground));
+  TEST_ASSERT_EQUAL(1, foreground);
+
+  for (int i = 0; i < 2; i++) {
+    TEST_ASSERT_EQUAL_STRING(screen(saved[i]).c_str(), screen(restored[i]).c_str());
+    TEST_ASSERT_EQUAL(saved[i].buf.cursorRow(), restored[i].buf.cursorRow());
+    TEST_ASSERT_EQUAL(saved[i].buf.cursorCol(), restored[i].buf.cursorCol());
+    TEST_ASSERT_EQUAL(saved[i].history.lines(), restored[i].history.lines());
+    TEST_ASSERT_EQUAL_STRING(history(saved[i]).c_str(), history(restored[i]).c_str());
+
+    // The parser carries on where it was: the CSI in progress, the
+    // charsets, the scroll region and the saved main screen
+    for (const char* more : {"1mq\033P$qr\033\\", "\033[?1049l\033[6n"}) {
+      feed(saved[i], more);
+      feed(restored[i], more);
+      TEST_ASSERT_EQUAL_STRING(replies(saved[i]).c_str(), replies(restored[i]).c_str());
+      TEST_ASSERT_EQUAL_STRING(screen(saved[i]).c_str(), screen(restored[i]).c_str());
+    }
+  }
+}
+
+class MemWriter : public StateWriter {
+ public:
+  std::string data;
+  void write(const uint8_t* p, size_t n) override { data.append(reinterpret_cast<const char*>(p), n); }
+};
+
+class MemReader : public StateReader {
+ public:
+  MemReader(const std::string& data, size_t len) : _data(data), _end(len) {}
+  bool read(uint8_t* p, size_t n) override {
+    if (n > _end - _pos) return false;
+    memcpy(p, &_data[_pos], n);
+    _pos += n;
+    return true;
+  }
+
+ private:
+  const std::string& _data;
+  size_t _pos = 0, _end;
+};
+
+// Parser state that is cut short or out of range is refused without
+// touching the parser
+static void test_parser_restore_refused() {
+  TermSession& s = restored[0];
+  feed(s, "\033c\033)0\016\033[2");
+  MemWriter before;
+  s.parser.save(before);
+
+  MemWriter other;
+  saved[1].parser.save(other);
+  for (size_t len = 0; len < other.data.size(); len++) {
+    MemReader r(other.data, len);
+    TEST_ASSERT_FALSE(s.parser.restore(r));
+  }
+  std::string bad = other.data;
+  bad[0] = char(0xFF);  // no such parser state
+  MemReader r(bad, bad.size());
+  TEST_ASSERT_FALSE(s.parser.restore(r));
+
+  MemWriter after;
+  s.parser.save(after);
+  TEST_ASSERT_TRUE(before.data == after.data);
+  feed(s, "Jq");
+  TEST_ASSERT_EQUAL(0x2500, s.buf.cellAt(0, 0).codepoint);
+}
+
+// A damaged or cleared snapshot is refused, as is one taken with a
+// different number of sessions
+static void test_refused() {
+  TEST_ASSERT_TRUE(snapshot.save(0, false, saved, 2, 0));
+  uint8_t font, foreground;
+  bool portrait;
+  flash[100] ^= 1;
+  TEST_ASSERT_FALSE(snapshot.probe(font, portrait));
+  flash[100] ^= 1;
+  TEST_ASSERT_TRUE(snapshot.probe(font, portrait));
+  TEST_ASSERT_FALSE(snapshot.restore(restored, 1, foreground));
+
+  snapshot.invalidate();
+  TEST_ASSERT_FALSE(snapshot.probe(font, portrait));
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_parser_restore_refused);
+  RUN_TEST(test_refused);
+  return UNITY_END();
+}
@@ -0,0 +1,145 @@
+#include <unity.h>
+#include <cstdlib>
+#include <vector>
+#include "Utf8Decoder.h"
+
+// The decoder against a plain encoder, the replacement rules for malformed
+// input, and the word-at-a-time helpers against step().
+
+using Codepoints = std::vector<uint32_t>;
+using Bytes = std::vector<uint8_t>;
+
+static void encode(uint32_t cp, Bytes& out) {
+  if (cp < 0x80) {
+    out.push_back(cp);
+  } else if (cp < 0x800) {
+    out.push_back(0xC0 | (cp >> 6));
+    out.push_back(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    out.push_back(0xE0 | (cp >> 12));
+    out.push_back(0x80 | ((cp >> 6) & 0x3F));
+    out.push_back(0x80 | (cp & 0x3F));
+  } else {
+    out.push_back(0xF0 | (cp >> 18));
+    out.push_back(0x80 | ((cp >> 12) & 0x3F));
+    out.push_back(0x80 | ((cp >> 6) & 0x3F));
+    out.push_back(0x80 | (cp & 0x3F));
+  }
+}
+
+// One byte at a time, as the parser does; a sequence cut off by the end of
+// input is replaced
+static Codepoints decode(const Bytes& in) {
+  Utf8Decoder d;
+  Codepoints out;
+  for (uint8_t b : in) {
+    bool reprocess;
+    do {
+      reprocess = false;
+      uint32_t cp = d.step(b, reprocess);
+      if (cp != Utf8Decoder::NEED_MORE) out.push_back(cp);
+    } while (reprocess);
+  }
+  if (d.pending()) out.push_back(Utf8Decoder::REPLACEMENT);
+  return out;
+}
+
+static uint32_t randomCodepoint() {
+  switch (rand() % 4) {
+    case 0: return rand() % 0x80;
+    case 1: return 0x80 + rand() % (0x800 - 0x80);
+    case 2: {
+      uint32_t cp = 0x800 + rand() % (0x10000 - 0x800);
+      return cp >= 0xD800 && cp <= 0xDFFF ? cp + 0x800 : cp;
+    }
+    default: return 0x10000 + rand() % (0x110000 - 0x10000);
+  }
+}
+
+static void test_valid_round_trip() {
+  srand(1);
+  for (int i = 0; i < 500; i++) {
+    Codepoints cps;
+    Bytes bytes;
+    for (int n = rand() % 64; n > 0; n--) {
+      cps.push_back(randomCodepoint());
+      encode(cps.back(), bytes);
+    }
+    TEST_ASSERT_TRUE(decode(bytes) == cps);
+  }
+}
+
+// One U+FFFD per maximal invalid subpart
+static void test_malformed_input() {
+  const uint32_t R = Utf8Decoder::REPLACEMENT;
+  struct Case {
+    Bytes in;
+    Codepoints out;
+  };
+  const Case cases[] = {
+      {{0x80}, {R}},                                   // stray continuation
+      {{0xC0, 0xAF}, {R, R}},                          // overlong lead
+      {{0xE0, 0x80, 0xAF}, {R, R, R}},                 // overlong 3-byte
+      {{0xED, 0xA0, 0x80}, {R, R, R}},                 // surrogate
+      {{0xF4, 0x90, 0x80, 0x80}, {R, R, R, R}},        // above U+10FFFF
+      {{0xF5, 'a'}, {R, 'a'}},                         // no such lead
+      {{0xE2, 0x94, 'A'}, {R, 'A'}},                   // truncated, then ASCII
+      {{0xE2, 0x94, 0xE2, 0x94, 0x80}, {R, 0x2500}},   // truncated, then a new sequence
+      {{0xF0, 0x9F, 0x98}, {R}},                       // cut off by the end
+  };
+  for (const Case& c : cases) TEST_ASSERT_TRUE(decode(c.in) == c.out);
+}
+
+// Random bytes biased towards UTF-8 structure
+static Bytes noisyBytes() {
+  Bytes b;
+  for (int n = rand() % 128; n > 0; n--) {
+    if (rand() % 8) encode(randomCodepoint(), b);
+    else b.push_back(rand() % 256);
+  }
+  return b;
+}
+
+static void test_scan_printable_matches_bytes() {
+  srand(2);
+  for (int i = 0; i < 2000; i++) {
+    Bytes b = noisyBytes();
+    for (size_t start = 0; start <= b.size(); start += 1 + rand() % 8) {
+      const uint8_t* p = b.data() + start;
+      const uint8_t* end = b.data() + b.size();
+      const uint8_t* want = p;
+      while (want < end && *want >= 0x20 && *want < 0x7F) want++;
+      TEST_ASSERT_TRUE(Utf8Decoder::scanPrintable(p, end) == want);
+    }
+  }
+}
+
+// decodeRun() takes only well-formed sequences and yields what step() would
+static void test_decode_run_matches_step() {
+  srand(3);
+  for (int i = 0; i < 2000; i++) {
+    Bytes b = noisyBytes();
+    const uint8_t* p = b.data();
+    const uint8_t* end = b.data() + b.size();
+    while (p < end) {
+      Codepoints bulk;
+      const uint8_t* stop = Utf8Decoder::decodeRun(p, end, [&](uint32_t cp) { bulk.push_back(cp); });
+      Codepoints stepped = decode(Bytes(p, stop));
+      TEST_ASSERT_TRUE(bulk == stepped);
+      for (uint32_t cp : bulk) TEST_ASSERT_TRUE(cp >= 0x80);
+      p = stop == p ? p + 1 : stop;
+    }
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_valid_round_trip);
+  RUN_TEST(test_malformed_input);
+  RUN_TEST(test_scan_printable_matches_bytes);
+  RUN_TEST(test_decode_run_matches_step);
+  return UNITY_END();
+}